@@ -8,6 +8,26 @@
 
 namespace v8toolkit {
 
+
+/**
+ * Information about a type which is the same for every AnyPtr of that type, so it is computed once per type
+ *   instead of once per object
+ */
+struct AnyTypeDescriptor {
+    std::string type_name;
+};
+
+
+/**
+ * Returns the single, lazily-created AnyTypeDescriptor for type T
+ */
+template<class T>
+AnyTypeDescriptor const & get_any_type_descriptor() {
+    static AnyTypeDescriptor descriptor{xl::demangle<T>()};
+    return descriptor;
+}
+
+
 /**
  * Class used to store an object of an arbitrary type and allow runtime querying of the type contained
  * via dyanmic_cast of the AnyBase object to an AnyPtr<T> object.
@@ -15,10 +35,15 @@ namespace v8toolkit {
 struct AnyBase {
     virtual ~AnyBase();
 
-    std::string type_name;
+    // shared by all objects of the same contained type
+    AnyTypeDescriptor const & type_descriptor;
 
-    AnyBase(const std::string type_name)
-        : type_name(std::move(type_name)) {}
+    AnyBase(AnyTypeDescriptor const & type_descriptor)
+        : type_descriptor(type_descriptor) {}
+
+    std::string const & type_name() const {
+        return this->type_descriptor.type_name;
+    }
 
     template <typename T>
     T const * get() const;
@@ -42,7 +67,7 @@ private:
 
 public:
     AnyPtr(T * data) :
-        AnyBase(xl::demangle<T>()),
+        AnyBase(get_any_type_descriptor<T>()),
         data(data) {}
 
 
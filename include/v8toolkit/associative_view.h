@@ -0,0 +1,292 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+#include <v8.h>
+
+#include "v8_class_wrapper.h"
+
+namespace v8toolkit {
+
+
+/**
+ * Returned to JavaScript in place of an associative container (std::map, std::unordered_map, std::set,
+ * std::multimap, eastl::vector_map, etc) to expose the live container instead of a copy of it.  The JavaScript
+ * object supports `get(key)`, `has(key)`, `size`, and for...of iteration.  Entries are converted one at a time as
+ * they are reached, so looking up a few keys in a large container doesn't convert the rest of it.
+ *
+ * Iteration yields [key, value] arrays for maps and keys for sets, like JavaScript Map and Set.  For containers
+ * with duplicate keys, `get` returns an array of all values for the key.
+ *
+ * If the view is created from a std::shared_ptr, or `invalidate()` is called on it, using the JavaScript object or
+ * any iterator created from it after the container is gone throws a JavaScript exception instead of touching freed
+ * memory.  Modifying the container while a JavaScript iterator is active has the same effect on the iterator as
+ * it would in C++.
+ */
+template<class Container>
+class AssociativeView {
+    using NoConstContainer = std::remove_cv_t<Container>;
+    using KeyT = typename NoConstContainer::key_type;
+    using ConstIteratorT = typename NoConstContainer::const_iterator;
+
+    template<class C, class = void>
+    struct has_mapped_type : std::false_type {};
+    template<class C>
+    struct has_mapped_type<C, std::void_t<typename C::mapped_type>> : std::true_type {};
+
+    static constexpr bool is_map = has_mapped_type<NoConstContainer>::value;
+
+
+    /**
+     * Shared by the view and all JavaScript objects created from it
+     */
+    struct State {
+        NoConstContainer const * container;
+        std::weak_ptr<void const> lifetime;
+        bool tracks_lifetime;
+
+        NoConstContainer const & get_container() const {
+            if (this->container == nullptr || (this->tracks_lifetime && this->lifetime.expired())) {
+                throw InvalidCallException("Associative container view used after its container was destroyed");
+            }
+            return *this->container;
+        }
+    };
+
+    struct IteratorState {
+        std::shared_ptr<State> state;
+        ConstIteratorT current;
+    };
+
+    std::shared_ptr<State> state;
+
+
+    // templates for view and iterator objects for this container type, per isolate
+    static inline MapT<v8::Isolate *, v8::Global<v8::ObjectTemplate>> view_templates;
+    static inline MapT<v8::Isolate *, v8::Global<v8::ObjectTemplate>> iterator_templates;
+
+
+    // More than one internal field, like ContainerView, so V8ClassWrapper never mistakes a view or iterator for a
+    //   wrapped object whose single internal field points to its WrappedObjectHeader
+    enum InternalFields {
+        DataField,
+        TagField,
+        InternalFieldCount
+    };
+
+    // address stored in TagField identifying what kind of Data is in DataField
+    template<class Data>
+    static inline char const data_tag = 0;
+
+
+    /**
+     * Stores a heap-allocated Data in the object's internal field, deleted when the object is garbage collected
+     */
+    template<class Data>
+    static void attach_data(v8::Isolate * isolate, v8::Local<v8::Object> object, Data * data) {
+        object->SetInternalField(DataField, v8::External::New(isolate, data));
+        object->SetInternalField(TagField, v8::External::New(isolate, const_cast<char *>(&data_tag<Data>)));
+        global_set_weak(isolate, object, [data](v8::WeakCallbackInfo<SetWeakCallbackData> const &) {
+            delete data;
+        }, false);
+    }
+
+    template<class Data>
+    static Data & get_data(v8::Local<v8::Object> object) {
+        if (object->InternalFieldCount() != InternalFieldCount ||
+            !object->GetInternalField(TagField)->IsExternal() ||
+            v8::Local<v8::External>::Cast(object->GetInternalField(TagField))->Value() != &data_tag<Data>) {
+            throw InvalidCallException("Associative container view method called on wrong type of object");
+        }
+        return *static_cast<Data *>(v8::Local<v8::External>::Cast(object->GetInternalField(DataField))->Value());
+    }
+
+    static NoConstContainer const & get_container(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        return get_data<std::shared_ptr<State>>(info.This())->get_container();
+    }
+
+
+    static v8::Local<v8::Value> convert_entry(v8::Isolate * isolate, typename NoConstContainer::value_type const & entry) {
+        if constexpr(is_map) {
+            auto context = isolate->GetCurrentContext();
+            auto pair = v8::Array::New(isolate, 2);
+            (void)pair->Set(context, 0, CastToJS<KeyT const &>()(isolate, entry.first));
+            (void)pair->Set(context, 1, CastToJS<typename NoConstContainer::mapped_type const &>()(isolate, entry.second));
+            return pair;
+        } else {
+            return CastToJS<KeyT const &>()(isolate, entry);
+        }
+    }
+
+
+    // runs the body of a JavaScript-callable function, turning C++ exceptions into JavaScript exceptions
+    template<class Callable>
+    static void call_from_js(v8::FunctionCallbackInfo<v8::Value> const & info, Callable && callable) {
+        auto isolate = info.GetIsolate();
+        try {
+            callable(isolate);
+        } catch (std::exception & e) {
+            V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception in associative container view: {}", e.what());
+            isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+        }
+    }
+
+
+    static void js_get(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        call_from_js(info, [&](v8::Isolate * isolate) {
+            auto & container = get_container(info);
+            auto key = CastToNative<KeyT>()(isolate, info[0]);
+            if constexpr(has_unique_keys_v<NoConstContainer>) {
+                auto found = container.find(key);
+                if (found == container.end()) {
+                    return;
+                }
+                if constexpr(is_map) {
+                    info.GetReturnValue().Set(CastToJS<typename NoConstContainer::mapped_type const &>()(isolate, found->second));
+                } else {
+                    info.GetReturnValue().Set(CastToJS<KeyT const &>()(isolate, *found));
+                }
+            } else {
+                auto context = isolate->GetCurrentContext();
+                auto matches = v8::Array::New(isolate);
+                uint32_t i = 0;
+                auto range = container.equal_range(key);
+                for (auto match = range.first; match != range.second; match++) {
+                    if constexpr(is_map) {
+                        (void)matches->Set(context, i++, CastToJS<typename NoConstContainer::mapped_type const &>()(isolate, match->second));
+                    } else {
+                        (void)matches->Set(context, i++, CastToJS<KeyT const &>()(isolate, *match));
+                    }
+                }
+                info.GetReturnValue().Set(matches);
+            }
+        });
+    }
+
+
+    static void js_has(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        call_from_js(info, [&](v8::Isolate * isolate) {
+            auto & container = get_container(info);
+            info.GetReturnValue().Set(container.find(CastToNative<KeyT>()(isolate, info[0])) != container.end());
+        });
+    }
+
+
+    static void js_size(v8::Local<v8::Name> property, v8::PropertyCallbackInfo<v8::Value> const & info) {
+        auto isolate = info.GetIsolate();
+        try {
+            info.GetReturnValue().Set(static_cast<double>(get_data<std::shared_ptr<State>>(info.Holder())->get_container().size()));
+        } catch (std::exception & e) {
+            isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+        }
+    }
+
+
+    static void js_iterator(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        call_from_js(info, [&](v8::Isolate * isolate) {
+            auto & state = get_data<std::shared_ptr<State>>(info.This());
+            auto iterator = get_template(isolate, iterator_templates)->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+            attach_data(isolate, iterator, new IteratorState{state, state->get_container().begin()});
+            info.GetReturnValue().Set(iterator);
+        });
+    }
+
+
+    static void js_iterator_next(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        call_from_js(info, [&](v8::Isolate * isolate) {
+            auto & iterator_state = get_data<IteratorState>(info.This());
+            auto & container = iterator_state.state->get_container();
+
+            auto context = isolate->GetCurrentContext();
+            auto result = v8::Object::New(isolate);
+            bool done = iterator_state.current == container.end();
+            (void)result->Set(context, make_js_key(isolate, V8TOOLKIT_STRING_KEY("done")), v8::Boolean::New(isolate, done));
+            if (done) {
+                (void)result->Set(context, make_js_key(isolate, V8TOOLKIT_STRING_KEY("value")), v8::Undefined(isolate));
+            } else {
+                (void)result->Set(context, make_js_key(isolate, V8TOOLKIT_STRING_KEY("value")), convert_entry(isolate, *iterator_state.current));
+                iterator_state.current++;
+            }
+            info.GetReturnValue().Set(result);
+        });
+    }
+
+
+    static void js_return_this(v8::FunctionCallbackInfo<v8::Value> const & info) {
+        info.GetReturnValue().Set(info.This());
+    }
+
+
+    static v8::Local<v8::ObjectTemplate> get_template(v8::Isolate * isolate, MapT<v8::Isolate *, v8::Global<v8::ObjectTemplate>> & templates) {
+        auto existing = templates.find(isolate);
+        if (existing != templates.end()) {
+            return existing->second.Get(isolate);
+        }
+
+        auto object_template = v8::ObjectTemplate::New(isolate);
+        object_template->SetInternalFieldCount(InternalFieldCount);
+        if (&templates == &view_templates) {
+            object_template->Set(v8::String::NewFromUtf8(isolate, "get"), v8::FunctionTemplate::New(isolate, js_get));
+            object_template->Set(v8::String::NewFromUtf8(isolate, "has"), v8::FunctionTemplate::New(isolate, js_has));
+            object_template->SetAccessor(v8::String::NewFromUtf8(isolate, "size"), js_size);
+            object_template->Set(v8::Symbol::GetIterator(isolate), v8::FunctionTemplate::New(isolate, js_iterator));
+        } else {
+            object_template->Set(v8::String::NewFromUtf8(isolate, "next"), v8::FunctionTemplate::New(isolate, js_iterator_next));
+            object_template->Set(v8::Symbol::GetIterator(isolate), v8::FunctionTemplate::New(isolate, js_return_this));
+        }
+
+        templates[isolate].Reset(isolate, object_template);
+        wrapper_registery.add_callback(isolate, [isolate, &templates] {
+            templates.erase(isolate);
+        });
+        return object_template;
+    }
+
+
+public:
+
+    /**
+     * View of a container which the caller guarantees outlives every JavaScript object created from the view,
+     * or until `invalidate` is called
+     */
+    AssociativeView(Container & container) :
+        state(std::make_shared<State>(State{&container, {}, false}))
+    {}
+
+    /**
+     * View of a container which becomes unusable from JavaScript once the last shared_ptr to the container is gone
+     */
+    AssociativeView(std::shared_ptr<Container> const & container) :
+        state(std::make_shared<State>(State{container.get(), container, true}))
+    {}
+
+
+    /**
+     * Makes every JavaScript object created from this view throw when used
+     */
+    void invalidate() {
+        this->state->container = nullptr;
+    }
+
+
+    /**
+     * Creates a JavaScript object viewing the container
+     */
+    v8::Local<v8::Object> make_js_object(v8::Isolate * isolate) const {
+        auto object = get_template(isolate, view_templates)->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+        attach_data(isolate, object, new std::shared_ptr<State>(this->state));
+        return object;
+    }
+};
+
+
+template<typename T, typename Behavior>
+struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<AssociativeView, T>>> {
+    v8::Local<v8::Value> operator()(v8::Isolate * isolate, std::remove_reference_t<T> const & view) const {
+        return view.make_js_object(isolate);
+    }
+};
+
+
+} // end namespace v8toolkit
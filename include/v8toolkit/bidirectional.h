@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <unordered_map>
 
 #define V8TOOLKIT_BIDIRECTIONAL_ENABLED
 #include "v8_class_wrapper.h"
@@ -42,12 +44,81 @@ protected:
     */
     mutable bool called_from_javascript = false;
 
+    struct JSMethodCacheEntry {
+        // what looking up the method's name on the JavaScript object found
+        v8::Global<v8::Value> property;
+
+        // the property, if it's a JavaScript override, otherwise empty and the C++ implementation is called directly
+        v8::Global<v8::Function> js_override;
+    };
+
+    /**
+     * What was decided about each JS_ACCESS method's JavaScript override, by method slot
+     */
+    mutable std::unordered_map<size_t, JSMethodCacheEntry> js_method_cache;
+
+    static inline std::atomic<size_t> next_js_method_slot{0};
+
 protected:
     JSWrapperBase(v8::Local<v8::Object> object) :
         global_js_object(v8::Global<v8::Object>(v8::Isolate::GetCurrent(), object))
     {}
 
+
+    /**
+     * Returns a new slot for caching a JS_ACCESS method's JavaScript override, unique across all types
+     */
+    static size_t new_js_method_slot() {
+        return next_js_method_slot++;
+    }
+
+
+    /**
+     * Returns the JavaScript function overriding the JS_ACCESS method in the given slot, or an empty handle if it
+     * isn't overridden.  Every call looks the name up again with GetRealNamedProperty, which searches the object's
+     * own properties and its whole prototype chain without calling interceptors, so assigning a method to the object
+     * or anywhere on its prototype chain is seen by the next call.  Deciding whether what was found is an override
+     * is only done again when the lookup finds something different.
+     *
+     * Functions not written in JavaScript, such as the wrapped C++ method of the base type, aren't overrides.
+     */
+    template<class Key>
+    v8::Local<v8::Function> get_js_method_override(v8::Isolate * isolate, size_t slot, Key key) const {
+        auto js_object = this->global_js_object.Get(isolate);
+
+        v8::TryCatch try_catch(isolate);
+        v8::Local<v8::Value> property;
+        if (!js_object->GetRealNamedProperty(isolate->GetCurrentContext(), make_js_key(isolate, key)).ToLocal(&property)) {
+            return {};
+        }
+
+        auto & cached = this->js_method_cache[slot];
+        if (!cached.property.IsEmpty() && cached.property.Get(isolate) == property) {
+            return cached.js_override.Get(isolate);
+        }
+
+        v8::Local<v8::Function> js_function;
+        if (property->IsFunction()) {
+            auto function = v8::Local<v8::Function>::Cast(property);
+            if (function->ScriptId() != v8::UnboundScript::kNoScriptId || function->GetBoundFunction()->IsFunction()) {
+                js_function = function;
+            }
+        }
+        cached.property.Reset(isolate, property);
+        cached.js_override.Reset(isolate, js_function);
+        return js_function;
+    }
+
 public:
+
+    /**
+     * Releases the functions cached for JS_ACCESS methods.  Not needed for correctness - changes to the object's
+     * methods are noticed on the next call - but drops the handles keeping replaced functions alive.
+     */
+    void invalidate_js_method_cache() const {
+        this->js_method_cache.clear();
+    }
+
     v8::Local<v8::Object> get_javascript_object() const { 
         if (global_js_object.IsEmpty()) {
             return {};
@@ -58,6 +129,10 @@ public:
 };
 
 
+template<typename Base, typename JSWrapperClass, typename Internal, typename External, auto constructor_function, typename Deleter>
+class JSFactory;
+
+
 /**
 * C++ types to be extended in javascript must inherit from this class.
 * Example: class MyClass{};  class JSMyClass : public MyClass, public JSWrapper<MyClass> {};
@@ -72,14 +147,48 @@ class JSWrapper : public JSWrapperBase {
 protected:
     using BASE_TYPE=Base; // used by JS_ACCESS macros
     
+private:
+    template<typename, typename, typename, typename, auto, typename>
+    friend class JSFactory;
+
+    /**
+     * Set by JSFactory while it constructs an object in [object_begin, object_end) so that object's JSWrapper<Base>
+     * creates its JavaScript object with the factory's function, which gives it its final prototype from the start.
+     * Any other JSWrapper<Base> created meanwhile, say by Base's constructor, lies outside the range and ignores it.
+     */
+    struct PendingInstanceConstructor {
+        void const * object_begin;
+        void const * object_end;
+        v8::Local<v8::Function> instance_constructor;
+    };
+    static inline thread_local PendingInstanceConstructor const * pending_instance_constructor = nullptr;
+
+
+    static v8::Local<v8::Object> wrap(Base * object) {
+        auto isolate = v8::Isolate::GetCurrent();
+        auto & wrapper = v8toolkit::V8ClassWrapper<Base>::get_instance(isolate);
+
+        v8::Local<v8::Function> instance_constructor;
+        if (auto pending = pending_instance_constructor; pending != nullptr &&
+            !std::less<void const *>()(object, pending->object_begin) &&
+            std::less<void const *>()(object, pending->object_end)) {
+
+            instance_constructor = pending->instance_constructor;
+
+            // data members of the object being constructed which are JSWrapper<Base>s themselves are in the range, too
+            pending_instance_constructor = nullptr;
+        }
+
+        return wrapper.wrap_existing_cpp_object(isolate->GetCurrentContext(),
+                                                object,
+                                                *wrapper.destructor_behavior_leave_alone,  // leave_alone may be wrong
+                                                true,
+                                                instance_constructor);
+    }
+
 public:
     JSWrapper(Base * object) :
-        JSWrapperBase(v8toolkit::V8ClassWrapper<Base>::get_instance(v8::Isolate::GetCurrent()).
-            wrap_existing_cpp_object(v8::Isolate::GetCurrent()->GetCurrentContext(),
-                                     object,
-                                     *v8toolkit::V8ClassWrapper<Base>::get_instance(v8::Isolate::GetCurrent()).destructor_behavior_leave_alone,  // leave_alone may be wrong 
-                                     true)
-        )
+        JSWrapperBase(wrap(object))
     {}
 };
 
@@ -348,6 +457,9 @@ protected:
     v8::Global<v8::Function> constructor;
     FactoryBase const * base_factory;
 
+    // creates the JavaScript objects for this type with `prototype` already in place, so they share a hidden class
+    v8::Global<v8::Function> instance_constructor;
+
 
     /**
      * Create a JSFactory from pure javascript.  
@@ -370,7 +482,7 @@ protected:
 
         // internal constructor params start 2 after the starting_info_index 
         int internal_param_index = starting_info_index + 3; // skip the base factory, prototype object and object constructor callback as well
-        std::vector<std::unique_ptr<v8toolkit::StuffBase>> stuff;
+        v8toolkit::ParameterStorageFor<FixedParams...> stuff;
 
        
         return std::make_unique<JSFactory>(
@@ -385,6 +497,108 @@ protected:
         return this->constructor.Get(v8::Isolate::GetCurrent());
     }
 
+
+    // allocated the way `delete` on the finished object expects
+    static void * allocate() {
+        static_assert(alignof(JSWrapperClass) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned JSWrapperClass types aren't supported");
+        if constexpr(has_class_operator_new_v<JSWrapperClass>) {
+            return JSWrapperClass::operator new(sizeof(JSWrapperClass));
+        } else {
+            return ::operator new(sizeof(JSWrapperClass));
+        }
+    }
+
+    static void deallocate(void * memory) {
+        if constexpr(has_class_operator_new_v<JSWrapperClass>) {
+            JSWrapperClass::operator delete(memory);
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+
+    /**
+     * Constructs the JSWrapperClass object, whose JSWrapper<Base> creates its JavaScript object with
+     * `instance_constructor`.  The memory is allocated first so the pending constructor can be tied to this object.
+     */
+    static JSWrapperClass * construct(v8::Local<v8::Function> instance_constructor,
+                                      FixedParams... fixed_params,
+                                      ExternalConstructorParams... constructor_params) {
+        using Pending = typename JSWrapper<Base>::PendingInstanceConstructor;
+
+        void * memory = allocate();
+        Pending pending{memory, static_cast<char *>(memory) + sizeof(JSWrapperClass), instance_constructor};
+
+        // restores whatever an enclosing construction had pending, even if the constructor throws
+        struct RestorePending {
+            Pending const * previous;
+            ~RestorePending() {
+                JSWrapper<Base>::pending_instance_constructor = this->previous;
+            }
+        } restore_pending{JSWrapper<Base>::pending_instance_constructor};
+        JSWrapper<Base>::pending_instance_constructor = &pending;
+
+        try {
+            return new(memory) JSWrapperClass(fixed_params..., constructor_params...);
+        } catch(...) {
+            deallocate(memory);
+            throw;
+        }
+    }
+
+
+    /**
+     * Creates the object through the base factories with the instance constructor of the factory it was requested
+     * from, then applies this factory's constructor function and JavaScript constructor
+     */
+    JSWrapperClass * create(v8::Local<v8::Function> instance_constructor,
+                            FixedParams... fixed_params,
+                            ExternalConstructorParams... constructor_params) const {
+
+        auto isolate = v8::Isolate::GetCurrent();
+        auto context = isolate->GetCurrentContext();
+
+        JSWrapperClass * const wrapper_class = [&]() {
+
+            JSWrapperClass * result = nullptr;
+            // at the least-derived JS factory, create the JSWrapperClass object
+            if (this->base_factory == nullptr) {
+                result = construct(instance_constructor, fixed_params..., constructor_params...);
+            } else {
+                result = this->base_factory->create(instance_constructor, fixed_params..., constructor_params...);
+            }
+            if constexpr(constructor_function != nullptr) {
+                (result->*constructor_function)();
+            }
+            return result;
+        }();
+
+
+        // only objects created some other way need their prototype changed, which makes V8 give them their own
+        //   hidden class
+        auto js_object = wrapper_class->get_javascript_object();
+        auto prototype = this->get_prototype();
+        bool has_prototype = false;
+        for (auto object = js_object->GetPrototype(); object->IsObject(); object = v8::Local<v8::Object>::Cast(object)->GetPrototype()) {
+            if (object == prototype) {
+                has_prototype = true;
+                break;
+            }
+        }
+        if (!has_prototype) {
+            js_object->SetPrototype(prototype);
+        }
+
+        call_javascript_function_with_vars(context,
+                                           this->get_constructor(),
+                                           wrapper_class->get_javascript_object(),
+                                           TypeList<ExternalConstructorParams...>(),
+                                           constructor_params...);
+        
+        
+        return wrapper_class;
+    }
+
     
 
 public:
@@ -422,6 +636,8 @@ public:
         }
         (void)constructor->SetPrototype(isolate->GetCurrentContext(), prototype);
 
+        this->instance_constructor.Reset(isolate, V8ClassWrapper<Base>::get_instance(isolate).
+            make_subclass_instance_constructor(isolate->GetCurrentContext(), prototype));
     }
 
     ~JSFactory(){
@@ -432,36 +648,8 @@ public:
     JSWrapperClass * operator()(FixedParams... fixed_params, 
                                 ExternalConstructorParams... constructor_params) const override {
 
-
-        auto isolate = v8::Isolate::GetCurrent();
-        auto context = isolate->GetCurrentContext();
-
-        JSWrapperClass * const wrapper_class = [&]() {
-
-            JSWrapperClass * result = nullptr;
-            // at the least-derived JS factory, create the JSWrapperClass object
-            if (this->base_factory == nullptr) {
-                result = new JSWrapperClass(fixed_params..., constructor_params...);
-            } else {
-                result = static_cast<JSWrapperClass *>(this->base_factory->operator()(fixed_params..., constructor_params...));
-            }
-            if constexpr(constructor_function != nullptr) {
-                (result->*constructor_function)();
-            }
-            return result;
-        }();
-
-       
-        wrapper_class->get_javascript_object()->SetPrototype(this->get_prototype());
-
-        call_javascript_function_with_vars(context,
-                                           this->get_constructor(),
-                                           wrapper_class->get_javascript_object(),
-                                           TypeList<ExternalConstructorParams...>(),
-                                           constructor_params...);
-        
-        
-        return wrapper_class;
+        // the most derived factory's function creates the JavaScript object
+        return this->create(this->instance_constructor.Get(v8::Isolate::GetCurrent()), fixed_params..., constructor_params...);
     }
 
 
@@ -574,7 +762,9 @@ struct is_wrapped_type<T, std::enable_if_t<xl::is_template_for_v<ConcreteFactory
 
 /**
 * This code looks for a javascript method on the JavaScript object contained
-*   in the "this" JSWrapper object and call the "name"d method on it.  It must work
+*   in the "this" JSWrapper object and call the "name"d method on it.  Which function that is - or that there
+*   isn't one and the C++ version should be called - is cached per object, see JSWrapperBase::get_js_method_override.
+*   It must work
 *   when this method is called directly to start the method call (using a bidirectional 
 *   object from C++) as well as when the method call is started from javascript (where the
 *   javascript interpreter checks the prototype chain initially and might find this function)
@@ -601,19 +791,18 @@ struct is_wrapped_type<T, std::enable_if_t<xl::is_template_for_v<ConcreteFactory
 	if(JS_ACCESS_CORE_DEBUG) printf("IN JS_ACCESS_CORE for %s, not calling native code\n", #js_name); \
     /*auto parameter_tuple = std::make_tuple( __VA_ARGS__ ); */ \
    /* auto parameter_tuple = make_tuple_for_variables(__VA_ARGS__); */ \
-    v8toolkit::CastToNative<std::remove_reference<ReturnType>::type> cast_to_native; \
+    static size_t const js_method_slot = v8toolkit::JSWrapperBase::new_js_method_slot(); \
     auto isolate = v8::Isolate::GetCurrent(); \
+    auto js_function = this->get_js_method_override(isolate, js_method_slot, V8TOOLKIT_STRING_KEY(#js_name)); \
+    if (js_function.IsEmpty()) { \
+        /* not overridden in JavaScript, so skip the round trip through it */ \
+        return this->BASE_TYPE::name( __VA_ARGS__ );			\
+    } \
+    v8toolkit::CastToNative<std::remove_reference<ReturnType>::type> cast_to_native; \
     auto context = isolate->GetCurrentContext(); \
     CONTEXT_SCOPED_RUN(context); \
     auto js_object = global_js_object.Get(isolate); \
-    v8::Local<v8::Function> js_function; \
     v8::TryCatch tc(isolate); \
-    try { \
-        js_function = v8toolkit::get_key_as<v8::Function>(context, js_object, #js_name); \
-    } catch (...) { \
-        return this->BASE_TYPE::name( __VA_ARGS__ );			\
-        /*assert(((void)"method probably not added to wrapped parent type", false) == true); throw; */ \
-    } \
     this->called_from_javascript = true; \
     auto result = v8toolkit::call_javascript_function_with_vars(context, js_function, js_object, typelist, ##__VA_ARGS__); \
     this->called_from_javascript = false; \
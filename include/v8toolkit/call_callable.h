@@ -9,6 +9,7 @@
 #include "v8helpers.h"
 #include "casts.h"
 #include "parameter_builder.h"
+#include "parameter_storage.h"
 #include "stdfunctionreplacement.h"
 
 
@@ -58,7 +59,7 @@ public:
         int i = 0;
 
         constexpr int default_arg_count = std::tuple_size<DefaultArgsTuple>::value;
-        std::vector<std::unique_ptr<StuffBase>> stuff;
+        ParameterStorageFor<Args...> stuff;
         info.GetReturnValue().
             Set(v8toolkit::CastToJS<ReturnType>()(info.GetIsolate(),
                                                   function(std::forward<InitialArg>(initial_arg),
@@ -86,7 +87,7 @@ struct CallCallable<func::function<void(InitialArg, Args...)>, InitialArg> {
         int i = 0;
         constexpr int default_arg_count = std::tuple_size<DefaultArgsTuple>::value;
 
-        std::vector<std::unique_ptr<StuffBase>> stuff;
+        ParameterStorageFor<Args...> stuff;
         run_function(function, info, std::forward<InitialArg>(initial_arg),
                      std::forward<Args>(
                          ParameterBuilder<Args>().template operator()<ArgIndexes - default_arg_count - 1>(info, i,
@@ -127,7 +128,7 @@ public:
         constexpr int minimum_user_parameters_required = user_parameter_count - default_arg_count;
 
 
-        std::vector<std::unique_ptr<StuffBase>> stuff;
+        ParameterStorageFor<Args...> stuff;
 
         info.GetReturnValue().Set(v8toolkit::CastToJS<ReturnType>()(info.GetIsolate(),
                                                                     function( 
@@ -171,7 +172,7 @@ struct CallCallable<func::function<void(Args...)>> {
         // 2 - 2 = 0 (lookup at std::get<0>(default_args_tuple)
         constexpr int minimum_user_parameters_required = user_parameter_count - default_arg_count;
 
-        std::vector<std::unique_ptr<StuffBase>> stuff;
+        ParameterStorageFor<Args...> stuff;
         function(ParameterBuilder<Args>().
             template operator()<(((int) ArgIndexes) - minimum_user_parameters_required), DefaultArgsTuple>(
             info, i, stuff, std::move(default_args_tuple))...);
@@ -69,7 +69,7 @@ v8::Local <v8::Value> call_javascript_function_with_vars(v8::Local <v8::Context>
     if (tc.HasCaught() || maybe_result.IsEmpty()) {
         ReportException(isolate, &tc);
         if (v8toolkit::static_any<std::is_const<std::remove_reference_t<OriginalTypes>>::value...>::value) {
-            log.info(LoggingSubjects::Subjects::RUNTIME_EXCEPTION,
+            V8TOOLKIT_LOG_INFO(LoggingSubjects::Subjects::RUNTIME_EXCEPTION,
                 "Some of the types are const, make sure what you are using them for is available on the const type\n");
         }
 //        ReportException(isolate, &tc);
@@ -115,11 +115,7 @@ v8::Local <v8::Value> call_javascript_function(v8::Local <v8::Context> context,
     auto isolate = context->GetIsolate();
     auto receiver = make_local(receiver_object);
 
-    auto has_own_property_result = receiver->HasOwnProperty(context,
-                                           v8::String::NewFromUtf8(isolate,
-                                                                   function_name.data(),
-                                                                   v8::String::NewStringType::kNormalString,
-                                                                   function_name.length()));
+    auto has_own_property_result = receiver->HasOwnProperty(context, make_js_key(isolate, function_name));
     if (!has_own_property_result.IsNothing()) {
         if (has_own_property_result.ToChecked()) {
 
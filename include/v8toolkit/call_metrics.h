@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <v8.h>
+
+namespace v8toolkit {
+
+class CallMetricsRegistry;
+
+
+/**
+ * What kind of native callable a CallMetrics is for
+ */
+enum class CallKind {
+    Function,     // added with add_function
+    Method,       // instance method, including "fake" methods and callable objects
+    StaticMethod, // method on a wrapped class's constructor function
+    Accessor,     // data member getter or setter
+    Constructor   // `new` on a wrapped class's constructor function
+};
+
+
+/**
+ * Counters for a single native callable exposed to JavaScript.  Updated with relaxed atomics so recording a call
+ * never takes a lock.
+ */
+class CallMetrics {
+public:
+    /**
+     * Latency histogram bucket N counts calls taking [2^N, 2^(N+1)) nanoseconds.  The last bucket also counts
+     * everything slower.
+     */
+    static constexpr size_t HistogramBucketCount = 32;
+
+    CallMetricsRegistry & registry;
+    std::string const class_name; // empty for plain functions
+    std::string const name;
+    CallKind const kind;
+
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> exceptions{0};
+    std::atomic<uint64_t> total_nanoseconds{0};
+    std::array<std::atomic<uint64_t>, HistogramBucketCount> latency_histogram{};
+
+    CallMetrics(CallMetricsRegistry & registry, std::string_view class_name, std::string_view name, CallKind kind) :
+        registry(registry),
+        class_name(class_name),
+        name(name),
+        kind(kind)
+    {}
+
+    CallMetrics(CallMetrics const &) = delete;
+    CallMetrics & operator=(CallMetrics const &) = delete;
+
+    static size_t get_histogram_bucket(uint64_t nanoseconds) {
+        size_t bucket = 0;
+        while (nanoseconds > 1 && bucket < HistogramBucketCount - 1) {
+            nanoseconds >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    void record(uint64_t nanoseconds, bool exception) {
+        this->calls.fetch_add(1, std::memory_order_relaxed);
+        if (exception) {
+            this->exceptions.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->total_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        this->latency_histogram[get_histogram_bucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reset() {
+        this->calls = 0;
+        this->exceptions = 0;
+        this->total_nanoseconds = 0;
+        for (auto & bucket : this->latency_histogram) {
+            bucket = 0;
+        }
+    }
+};
+
+
+/**
+ * Point-in-time copy of a CallMetrics
+ */
+struct CallMetricsReportEntry {
+    std::string class_name;
+    std::string name;
+    CallKind kind;
+    uint64_t calls;
+    uint64_t exceptions;
+    uint64_t total_nanoseconds;
+    std::array<uint64_t, CallMetrics::HistogramBucketCount> latency_histogram;
+
+    /**
+     * Returns an upper bound on the latency of the given fraction of calls, based on the histogram buckets
+     * @param percentile value between 0 and 1
+     * @return nanoseconds
+     */
+    uint64_t get_latency_percentile(double percentile) const {
+        if (this->calls == 0) {
+            return 0;
+        }
+        auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile * this->calls)));
+        uint64_t seen = 0;
+        size_t bucket = 0;
+        for (; bucket < this->latency_histogram.size() - 1; bucket++) {
+            seen += this->latency_histogram[bucket];
+            if (seen >= target) {
+                break;
+            }
+        }
+        return (uint64_t(1) << (bucket + 1)) - 1;
+    }
+};
+
+
+/**
+ * Per-isolate collection of CallMetrics for every callable exposed through v8toolkit.  Metrics are registered for
+ * every callable as it is added, but nothing is recorded until the registry is enabled, so leaving it disabled only
+ * costs a relaxed atomic load per call.  Once enabled, each call costs two clock reads and a few relaxed atomic adds.
+ */
+class CallMetricsRegistry {
+    v8::Isolate * isolate;
+    std::atomic<bool> enabled{false};
+
+    // stable addresses for the CallMetrics referenced from callbacks
+    std::deque<CallMetrics> metrics;
+
+    // the same callable added again, such as a function added to every new context, reuses its metrics
+    std::map<std::tuple<std::string, std::string, CallKind>, CallMetrics *, std::less<>> metrics_by_key;
+    mutable std::mutex metrics_mutex;
+
+    static inline std::vector<std::unique_ptr<CallMetricsRegistry>> registries;
+    static inline std::mutex registries_mutex;
+
+public:
+    explicit CallMetricsRegistry(v8::Isolate * isolate) : isolate(isolate) {}
+
+    CallMetricsRegistry(CallMetricsRegistry const &) = delete;
+    CallMetricsRegistry & operator=(CallMetricsRegistry const &) = delete;
+
+
+    /**
+     * Returns the registry for the given isolate, creating it if necessary
+     */
+    static CallMetricsRegistry & get(v8::Isolate * isolate) {
+        std::lock_guard<std::mutex> lock(registries_mutex);
+        for (auto & registry : registries) {
+            if (registry->isolate == isolate) {
+                return *registry;
+            }
+        }
+        return *registries.emplace_back(std::make_unique<CallMetricsRegistry>(isolate));
+    }
+
+
+    /**
+     * Destroys the registry for the given isolate.  Must only be called once nothing can call into the isolate.
+     */
+    static void release(v8::Isolate * isolate) {
+        std::lock_guard<std::mutex> lock(registries_mutex);
+        registries.erase(std::remove_if(registries.begin(), registries.end(), [isolate](auto & registry) {
+            return registry->isolate == isolate;
+        }), registries.end());
+    }
+
+
+    /**
+     * Turns recording on or off for all callables in the isolate.  Counts collected so far are kept.
+     */
+    void set_enabled(bool enabled) {
+        this->enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool is_enabled() const {
+        return this->enabled.load(std::memory_order_relaxed);
+    }
+
+
+    /**
+     * Returns the metrics for a newly exposed callable, creating them the first time a callable with the same
+     * class name, name and kind is added
+     * @param class_name name of the wrapped class the callable belongs to, or empty for plain functions
+     * @param name JavaScript name of the callable
+     * @param kind what sort of callable it is
+     * @return metrics which live as long as the registry
+     */
+    CallMetrics & add(std::string_view class_name, std::string_view name, CallKind kind) {
+        std::lock_guard<std::mutex> lock(this->metrics_mutex);
+        auto existing = this->metrics_by_key.find(std::make_tuple(class_name, name, kind));
+        if (existing != this->metrics_by_key.end()) {
+            return *existing->second;
+        }
+        auto & metrics = this->metrics.emplace_back(*this, class_name, name, kind);
+        this->metrics_by_key.emplace(std::make_tuple(std::string(class_name), std::string(name), kind), &metrics);
+        return metrics;
+    }
+
+
+    /**
+     * Returns a copy of the current values of all metrics, including those which have never been called
+     */
+    std::vector<CallMetricsReportEntry> get_report() const {
+        std::lock_guard<std::mutex> lock(this->metrics_mutex);
+        std::vector<CallMetricsReportEntry> report;
+        report.reserve(this->metrics.size());
+        for (auto & metrics : this->metrics) {
+            auto & entry = report.emplace_back(CallMetricsReportEntry{
+                metrics.class_name,
+                metrics.name,
+                metrics.kind,
+                metrics.calls.load(std::memory_order_relaxed),
+                metrics.exceptions.load(std::memory_order_relaxed),
+                metrics.total_nanoseconds.load(std::memory_order_relaxed)});
+            for (size_t i = 0; i < CallMetrics::HistogramBucketCount; i++) {
+                entry.latency_histogram[i] = metrics.latency_histogram[i].load(std::memory_order_relaxed);
+            }
+        }
+        return report;
+    }
+
+
+    /**
+     * Zeroes all counters without unregistering anything
+     */
+    void reset() {
+        std::lock_guard<std::mutex> lock(this->metrics_mutex);
+        for (auto & metrics : this->metrics) {
+            metrics.reset();
+        }
+    }
+};
+
+
+/**
+ * Records a single call into a CallMetrics when it goes out of scope, if recording is enabled for its registry
+ * when it is created.
+ */
+class CallTimer {
+    CallMetrics * metrics;
+    std::chrono::steady_clock::time_point start;
+    bool exception = false;
+
+public:
+    explicit CallTimer(CallMetrics * metrics) :
+        metrics(metrics != nullptr && metrics->registry.is_enabled() ? metrics : nullptr)
+    {
+        if (this->metrics != nullptr) {
+            this->start = std::chrono::steady_clock::now();
+        }
+    }
+
+    CallTimer(CallTimer const &) = delete;
+    CallTimer & operator=(CallTimer const &) = delete;
+
+    /**
+     * Marks the call as having ended by throwing an exception into JavaScript
+     */
+    void set_exception() {
+        this->exception = true;
+    }
+
+    ~CallTimer() {
+        if (this->metrics != nullptr) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start);
+            this->metrics->record(static_cast<uint64_t>(elapsed.count()), this->exception);
+        }
+    }
+};
+
+
+} // end namespace v8toolkit
@@ -11,6 +11,8 @@
 #include <v8.h>
 
 #include "cast_to_js.h"
+#include "v8helpers.h"
+#include "typed_array.h"
 
 
 
@@ -92,7 +94,9 @@ CAST_TO_JS(double, { return v8::Number::New(isolate, value); });
 CAST_TO_JS(long double, { return v8::Number::New(isolate, value); });
 
 
-CAST_TO_JS(std::string, { return v8::String::NewFromUtf8(isolate, value.c_str(), v8::String::kNormalString, value.length()); });
+CAST_TO_JS(std::string, { return make_js_string(isolate, value); });
+
+CAST_TO_JS(std::string_view, { return make_js_string(isolate, value); });
 
 CAST_TO_JS(char *, { return v8::String::NewFromUtf8(isolate, value); });
 
@@ -137,6 +141,62 @@ struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<v8::Global,
 
 
 
+/**
+ * Collects converted elements and then creates the JavaScript array holding all of them in a single call, instead of
+ * growing an empty array with one Set per element.  Arrays of up to StackCapacity elements don't allocate.
+ */
+class JSArrayBuilder {
+    static constexpr size_t StackCapacity = 64;
+
+    v8::Local<v8::Value> stack_elements[StackCapacity];
+    std::vector<v8::Local<v8::Value>> heap_elements;
+    v8::Local<v8::Value> * elements;
+    size_t capacity;
+    size_t length = 0;
+
+public:
+    /**
+     * @param capacity exact number of elements which will be added
+     */
+    explicit JSArrayBuilder(size_t capacity) :
+        elements(stack_elements),
+        capacity(capacity)
+    {
+        if (capacity > StackCapacity) {
+            this->heap_elements.resize(capacity);
+            this->elements = this->heap_elements.data();
+        }
+    }
+
+    JSArrayBuilder(JSArrayBuilder const &) = delete;
+    JSArrayBuilder & operator=(JSArrayBuilder const &) = delete;
+
+    void push_back(v8::Local<v8::Value> element) {
+        assert(this->length < this->capacity);
+        this->elements[this->length++] = element;
+    }
+
+    v8::Local<v8::Array> build(v8::Isolate * isolate) {
+        return v8::Array::New(isolate, this->elements, this->length);
+    }
+};
+
+
+/**
+ * Converts the elements of a container being sent to JavaScript.  Anything that's the same for every element is
+ * looked up once in the constructor instead of once per element.  Specialized for wrapped types in v8_class_wrapper.h
+ */
+template<typename ElementT, typename Behavior, typename = void>
+struct CastToJSElement {
+    explicit CastToJSElement(v8::Isolate *) {}
+
+    template<typename U>
+    v8::Local<v8::Value> operator()(U && element) {
+        return Behavior()(std::forward<U>(element));
+    }
+};
+
+
 // CastToJS<std::pair<>>
 template<typename T, typename Behavior>
 struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<std::pair, T>>> {
@@ -146,11 +206,8 @@ struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<std::pair, T
 //        using T2 = typename T::second_type;
 
         assert(isolate->InContext());
-        auto context = isolate->GetCurrentContext();
-        auto array = v8::Array::New(isolate);
-        (void) array->Set(context, 0, Behavior()(pair.first));
-        (void) array->Set(context, 1, Behavior()(pair.second));
-        return array;
+        v8::Local<v8::Value> elements[] = {Behavior()(pair.first), Behavior()(pair.second)};
+        return v8::Array::New(isolate, elements, 2);
     }
 };
 
@@ -185,17 +242,15 @@ v8::Local<v8::Value> cast_to_js_vector_helper(v8::Isolate * isolate, T vector) {
     using NoRefT = std::remove_reference_t<T>;
 
     assert(isolate->InContext());
-    auto context = isolate->GetCurrentContext();
-    auto array = v8::Array::New(isolate);
+    JSArrayBuilder elements(vector.size());
+    CastToJSElement<typename NoRefT::value_type, Behavior> cast_element(isolate);
 
     using RefMatchedValueType = std::conditional_t<std::is_lvalue_reference_v<T>, typename NoRefT::value_type &, typename NoRefT::value_type &&>;
 
-    int i = 0;
     for (auto & element : vector) {
-        (void) array->Set(context, i, Behavior()(const_cast<RefMatchedValueType>(element)));
-        i++;
+        elements.push_back(cast_element(const_cast<RefMatchedValueType>(element)));
     }
-    return array;
+    return elements.build(isolate);
 }
 
 
@@ -204,11 +259,19 @@ template<typename T, typename Behavior>
 struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<std::vector, T>>> {
     using NoRefT = std::remove_reference_t<T>;
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT && vector) const {
-        return cast_to_js_vector_helper<NoRefT &&, Behavior>(isolate, std::move(vector));
+        if constexpr(cast_to_js_as_typed_array_v<typename NoRefT::value_type> && !std::is_const_v<NoRefT>) {
+            return move_vector_to_typed_array(isolate, std::move(vector));
+        } else {
+            return cast_to_js_vector_helper<NoRefT &&, Behavior>(isolate, std::move(vector));
+        }
     }
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT const & vector) const {
-        return cast_to_js_vector_helper<NoRefT const &, Behavior>(isolate, vector);
+        if constexpr(cast_to_js_as_typed_array_v<typename NoRefT::value_type>) {
+            return copy_to_typed_array(isolate, vector.data(), vector.size());
+        } else {
+            return cast_to_js_vector_helper<NoRefT const &, Behavior>(isolate, vector);
+        }
     }
 };
 
@@ -219,14 +282,12 @@ struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<std::list, T
     using NoRefT = std::remove_reference_t<T>;
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT const & list) {
             assert(isolate->InContext());
-            auto context = isolate->GetCurrentContext();
-            auto array = v8::Array::New(isolate);
-            int i = 0;
+            JSArrayBuilder elements(list.size());
+            CastToJSElement<typename NoRefT::value_type const, Behavior> cast_element(isolate);
             for (auto & element : list) {
-                (void) array->Set(context, i, Behavior()(element));
-                i++;
+                elements.push_back(cast_element(element));
             }
-            return array;
+            return elements.build(isolate);
     }
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT && list) {
@@ -270,9 +331,7 @@ v8::Local<v8::Object> casttojs_multimaplike(v8::Isolate * isolate, T const & mul
         bool map_has_key = map->Has(context, key).FromMaybe(default_value);
         if (!map_has_key) {
             // get the existing array, add this value to the end
-            auto array = v8::Array::New(isolate);
-            (void) array->Set(context, 0, value);
-            (void) map->Set(context, key, array);
+            (void) map->Set(context, key, v8::Array::New(isolate, &value, 1));
         } else {
             // create an array, add the current value to it, then add it to the object
             auto existing_array_value = map->Get(context, key).ToLocalChecked();
@@ -332,13 +391,14 @@ struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<std::deque,
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT & deque) {
         assert(isolate->InContext());
-        auto context = isolate->GetCurrentContext();
-        auto array = v8::Array::New(isolate);
-        auto size = deque.size();
-        for (unsigned int i = 0; i < size; i++) {
-            (void) array->Set(context, i, Behavior()(deque[i]));
+        JSArrayBuilder elements(deque.size());
+        // elements of a const container are const
+        CastToJSElement<std::conditional_t<std::is_const_v<NoRefT>, typename NoRefT::value_type const, typename NoRefT::value_type>,
+                        Behavior> cast_element(isolate);
+        for (auto & element : deque) {
+            elements.push_back(cast_element(element));
         }
-        return array;
+        return elements.build(isolate);
     }
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT && deque) {
@@ -353,13 +413,14 @@ struct CastToJS<T, Behavior, std::enable_if_t<xl::is_std_array_v<T>>> {
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT & arr) {
         assert(isolate->InContext());
-        auto context = isolate->GetCurrentContext();
-        auto array = v8::Array::New(isolate);
-        // auto size = arr.size();
-        for (unsigned int i = 0; i < arr.size(); i++) {
-            (void) array->Set(context, i, Behavior()(arr[i]));
+        JSArrayBuilder elements(arr.size());
+        // elements of a const container are const
+        CastToJSElement<std::conditional_t<std::is_const_v<NoRefT>, typename NoRefT::value_type const, typename NoRefT::value_type>,
+                        Behavior> cast_element(isolate);
+        for (auto & element : arr) {
+            elements.push_back(cast_element(element));
         }
-        return array;
+        return elements.build(isolate);
     }
 
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT && arr) {
@@ -409,14 +470,33 @@ struct CastToJS<std::shared_ptr<T>, Behavior> {
 };
 
 
+/**
+ * Immutable shared strings at least this long are given to JavaScript as external strings using the C++ string's
+ * memory instead of being copied
+ */
+constexpr size_t external_string_minimum_length = 1024;
+
+template<typename Behavior>
+struct CastToJS<std::shared_ptr<std::string const>, Behavior> {
+    v8::Local<v8::Value> operator()(v8::Isolate * isolate, std::shared_ptr<std::string const> const & shared_ptr) {
+        if (shared_ptr->length() >= external_string_minimum_length) {
+            return make_external_js_string(isolate, shared_ptr);
+        }
+        return make_js_string(isolate, *shared_ptr);
+    }
+};
+
+
 
 template<typename Behavior, typename... Args, size_t... Is>
 v8::Local<v8::Array> cast_tuple_to_js(v8::Isolate * isolate, std::tuple<Args...> const & tuple, std::index_sequence<Is...>) {
     assert(isolate->InContext());
-    auto context = isolate->GetCurrentContext();
-    v8::Local<v8::Array> array = v8::Array::New(isolate);
-    ((void)array->Set(context, Is, Behavior()(std::get<Is>(tuple))),...);
-    return array;
+    if constexpr(sizeof...(Is) == 0) {
+        return v8::Array::New(isolate);
+    } else {
+        v8::Local<v8::Value> elements[] = {Behavior()(std::get<Is>(tuple))...};
+        return v8::Array::New(isolate, elements, sizeof...(Is));
+    }
 }
 
 
@@ -2,12 +2,17 @@
 #pragma once
 
 #include <chrono>
+#include <limits>
+#if __cplusplus > 201703L && __has_include(<span>)
+#include <span>
+#endif
 
 #include <xl/demangle.h>
 
 #include "cast_to_native.h"
 #include "call_javascript_function.h"
 #include "v8helpers.h"
+#include "typed_array.h"
 
 namespace v8toolkit {
 
@@ -187,7 +192,17 @@ static constexpr bool callable(){return true;}
 template<typename Behavior>
 struct CastToNative<char *, Behavior> {
     std::unique_ptr<char[]> operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
-        return std::unique_ptr<char[]>(strdup(*v8::String::Utf8Value(isolate, value)));
+        if (value->IsString()) {
+            auto utf8 = get_utf8_scratch(isolate, v8::Local<v8::String>::Cast(value));
+            std::unique_ptr<char[]> result(new char[utf8.size() + 1]);
+            std::memcpy(result.get(), utf8.data(), utf8.size());
+            result[utf8.size()] = '\0';
+            return result;
+        }
+        v8::String::Utf8Value utf8(isolate, value);
+        std::unique_ptr<char[]> result(new char[utf8.length() + 1]);
+        std::memcpy(result.get(), *utf8, utf8.length() + 1);
+        return result;
     }
     static constexpr bool callable(){return true;}
 
@@ -221,7 +236,9 @@ struct CastToNative<std::basic_string<CharT, Traits, Allocator>, Behavior> {
 //        std::cerr << fmt::format("in cast to native string:") << std::endl;
 //        print_v8_value_details(value);
 
-        if (value->IsSymbol()) {
+        if (value->IsString()) {
+            return copy_js_string(isolate, v8::Local<v8::String>::Cast(value));
+        } else if (value->IsSymbol()) {
             return std::string(*v8::String::Utf8Value(isolate, v8::Local<v8::Symbol>::Cast(value)->Name()));
         } else {
             return std::string(*v8::String::Utf8Value(isolate, value));
@@ -232,6 +249,121 @@ struct CastToNative<std::basic_string<CharT, Traits, Allocator>, Behavior> {
 
 
 
+/**
+ * Points directly at the contents of an ArrayBuffer, TypedArray, or DataView without copying.  Spans of single-byte
+ * types view the raw bytes of any of them.  Spans of larger types require a TypedArray with exactly that element type,
+ * or an ArrayBuffer or DataView whose length and alignment fit a whole number of elements.
+ */
+template<class T, typename Behavior>
+struct CastToNative<Span<T>, Behavior> {
+    using ElementT = std::remove_cv_t<T>;
+    static_assert(std::is_arithmetic_v<ElementT> || std::is_same_v<ElementT, std::byte>, "Span can only view numbers or bytes");
+
+    Span<T> operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        auto bytes = get_array_buffer_bytes(value);
+        if (!bytes) {
+            throw CastException("CastToNative<{}> requires an ArrayBuffer or TypedArray but instead got JS: '{}'",
+                                xl::demangle<Span<T>>(), stringify_value(value));
+        }
+        if constexpr(sizeof(ElementT) > 1) {
+            if (value->IsTypedArray()) {
+                bool matches = false;
+                if constexpr(TypedArrayTraits<ElementT>::supported) {
+                    matches = TypedArrayTraits<ElementT>::matches(v8::Local<v8::TypedArray>::Cast(value));
+                }
+                if (!matches) {
+                    throw CastException("CastToNative<{}> TypedArray element type doesn't match: '{}'",
+                                        xl::demangle<Span<T>>(), stringify_value(value));
+                }
+            }
+            if (bytes->size() % sizeof(ElementT) != 0 || reinterpret_cast<uintptr_t>(bytes->data()) % alignof(ElementT) != 0) {
+                throw CastException("CastToNative<{}> byte length {} isn't a whole number of aligned {} byte elements",
+                                    xl::demangle<Span<T>>(), bytes->size(), sizeof(ElementT));
+            }
+        }
+        return Span<T>(reinterpret_cast<T *>(bytes->data()), bytes->size() / sizeof(ElementT));
+    }
+    static constexpr bool callable(){return true;}
+};
+
+
+#if __cplusplus > 201703L && __has_include(<span>)
+template<class T, size_t Extent, typename Behavior>
+struct CastToNative<std::span<T, Extent>, Behavior> {
+    std::span<T, Extent> operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        auto span = CastToNative<Span<T>, Behavior>()(isolate, value);
+        if constexpr(Extent != std::dynamic_extent) {
+            if (span.size() != Extent) {
+                throw CastException("CastToNative<{}> requires exactly {} elements but got {}",
+                                    xl::demangle<std::span<T, Extent>>(), Extent, span.size());
+            }
+        }
+        return std::span<T, Extent>(span.data(), span.size());
+    }
+    static constexpr bool callable(){return true;}
+};
+#endif
+
+
+/**
+ * Whether every value of arithmetic type From is exactly representable as To
+ */
+template<class From, class To>
+constexpr bool is_lossless_conversion_v =
+    std::is_same_v<From, To> ||
+    (std::is_arithmetic_v<From> && std::is_floating_point_v<To> &&
+     std::numeric_limits<From>::digits <= std::numeric_limits<To>::digits) ||
+    (std::is_integral_v<From> && std::is_integral_v<To> && (std::is_unsigned_v<From> || std::is_signed_v<To>) &&
+     std::numeric_limits<From>::digits <= std::numeric_limits<To>::digits);
+
+
+/**
+ * Fills an empty vector-like container of numbers from a numeric TypedArray by reading its backing store directly
+ * instead of getting one element at a time.  Elements which may not fit in the container's type, such as floating
+ * point elements read into integers, are converted one at a time with CastToNative, the same as for an Array.
+ * @return false if value isn't a TypedArray the container's elements can be read from
+ */
+template<class Container>
+bool read_typed_array(v8::Local<v8::Value> value, Container & container) {
+    using ValueType = typename Container::value_type;
+    if constexpr(TypedArrayTraits<ValueType>::supported) {
+        if (value->IsTypedArray()) {
+            auto typed_array = v8::Local<v8::TypedArray>::Cast(value);
+            if constexpr(has_contiguous_storage_v<Container>) {
+                if (TypedArrayTraits<ValueType>::matches(typed_array)) {
+                    container.resize(typed_array->Length());
+                    typed_array->CopyContents(container.data(), container.size() * sizeof(ValueType));
+                    return true;
+                }
+            }
+            bool lossless = false;
+            bool visited = visit_typed_array(typed_array, [&container, &lossless](auto const * data, size_t length) {
+                using ElementType = std::remove_cv_t<std::remove_pointer_t<decltype(data)>>;
+                if constexpr(is_lossless_conversion_v<ElementType, ValueType>) {
+                    lossless = true;
+                    for (size_t i = 0; i < length; i++) {
+                        container.emplace_back(static_cast<ValueType>(data[i]));
+                    }
+                }
+            });
+            if (!visited) {
+                return false;
+            }
+            if (!lossless) {
+                auto isolate = typed_array->GetIsolate();
+                auto context = isolate->GetCurrentContext();
+                auto length = typed_array->Length();
+                for (size_t i = 0; i < length; i++) {
+                    container.emplace_back(CastToNative<ValueType>()(isolate, typed_array->Get(context, static_cast<uint32_t>(i)).ToLocalChecked()));
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+
 template<typename Behavior, template<class,class...> class VectorTemplate, class T, class... Rest>
 auto vector_type_helper(v8::Isolate * isolate, v8::Local<v8::Value> value) {
     
@@ -243,6 +375,11 @@ auto vector_type_helper(v8::Isolate * isolate, v8::Local<v8::Value> value) {
 
     auto context = isolate->GetCurrentContext();
     ResultType v;
+
+    if (read_typed_array(value, v)) {
+        return v;
+    }
+
     if (value->IsArray()) {
         auto array = v8::Local<v8::Object>::Cast(value);
         auto array_length = get_array_length(isolate, array);
@@ -301,9 +438,31 @@ struct CastToNative<T, Behavior, std::enable_if_t<acts_like_array_v<T> && std::i
 
         auto context = isolate->GetCurrentContext();
         NonConstT a;
+        if constexpr(xl::is_template_for_v<std::vector, NonConstT>) {
+            if (read_typed_array(value, a)) {
+                return a;
+            }
+        }
         if (value->IsArray()) {
             auto array = v8::Local<v8::Object>::Cast(value);
             auto array_length = get_array_length(isolate, array);
+            if constexpr(xl::is_template_for_v<std::vector, NonConstT>) {
+                a.reserve(array_length);
+            }
+
+            // strings are copied straight into the vector without going through Behavior for each one
+            if constexpr(std::is_same_v<ValueT, std::string> && std::is_same_v<Behavior, CastToNativeDefaultBehavior>) {
+                for (int i = 0; i < array_length; i++) {
+                    auto element = array->Get(context, i).ToLocalChecked();
+                    if (element->IsString()) {
+                        a.push_back(copy_js_string(isolate, v8::Local<v8::String>::Cast(element)));
+                    } else {
+                        a.push_back(CastToNative<std::string>()(isolate, element));
+                    }
+                }
+                return a;
+            }
+
             auto back_inserter = std::back_inserter(a);
 
             for (int i = 0; i < array_length; i++) {
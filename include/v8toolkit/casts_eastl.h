@@ -41,11 +41,9 @@ struct CastToJS<T, Behavior, std::enable_if_t<
         using T2 = typename NoRefT::second_type;
 
         assert(isolate->InContext());
-        auto context = isolate->GetCurrentContext();
-        auto array = v8::Array::New(isolate);
-        (void) array->Set(context, 0, CastToJS<T1 &, Behavior>()(isolate, pair.first));
-        (void) array->Set(context, 1, CastToJS<T2 &, Behavior>()(isolate, pair.second));
-        return array;
+        v8::Local<v8::Value> elements[] = {CastToJS<T1 &, Behavior>()(isolate, pair.first),
+                                           CastToJS<T2 &, Behavior>()(isolate, pair.second)};
+        return v8::Array::New(isolate, elements, 2);
     }
 };
 
@@ -101,9 +99,14 @@ struct CastToNative<eastl::vector_multimap<Key, Value, Args...>, Behavior> {
     }
 };
 
-CAST_TO_NATIVE(eastl::string, {return eastl::string(*v8::String::Utf8Value(isolate, value)); });
+CAST_TO_NATIVE(eastl::string, {
+    if (value->IsString()) {
+        return copy_js_string<eastl::string>(isolate, v8::Local<v8::String>::Cast(value));
+    }
+    return eastl::string(*v8::String::Utf8Value(isolate, value));
+});
 
-CAST_TO_JS(eastl::string, {return v8::String::NewFromUtf8(isolate, value.c_str());});
+CAST_TO_JS(eastl::string, {return make_js_string(isolate, std::string_view(value.data(), value.size()));});
 
 
 template<typename T>
@@ -123,7 +126,7 @@ template<typename T, typename Behavior>
 struct CastToJS<T, Behavior, std::enable_if_t<
     IsEastlFixedString_v<T>>> {
     v8::Local<v8::Value> operator()(v8::Isolate * isolate, T const & value) const {
-        return v8::String::NewFromUtf8(isolate, value.c_str(), v8::String::kNormalString, value.length());
+        return make_js_string(isolate, std::string_view(value.data(), value.size()));
     }
 };
 
@@ -132,6 +135,10 @@ template<typename T, typename Behavior>
 struct CastToNative<T, Behavior, std::enable_if_t<
     IsEastlFixedString_v<T>>> {
     T operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        if (value->IsString()) {
+            auto utf8 = get_utf8_scratch(isolate, v8::Local<v8::String>::Cast(value));
+            return T(utf8.data(), utf8.data() + utf8.size());
+        }
         return T(*v8::String::Utf8Value(isolate, value));
     }
 };
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include <v8.h>
+
+#include "v8_class_wrapper.h"
+
+namespace v8toolkit {
+
+
+/**
+ * Returned to JavaScript in place of a random-access container (std::vector, std::deque, std::array, etc) to
+ * expose the live container instead of a copy of it.  The JavaScript object reads and optionally writes elements
+ * of the C++ container when they are accessed, so only the elements actually touched are converted.  It has a
+ * `length`, can be enumerated, and can be iterated with for...of.
+ *
+ * The container must outlive the JavaScript object.  If an owner object is specified, the owner is kept alive
+ * for as long as the view is.
+ *
+ * Writes are only possible to existing elements; the view can't change the size of the container.
+ */
+template<class Container>
+struct ContainerView {
+    using ValueT = std::remove_reference_t<decltype(std::declval<Container &>()[0])>;
+    using ElementT = typename std::remove_cv_t<Container>::value_type;
+
+    static constexpr bool can_write = !std::is_const_v<Container> && !std::is_const_v<ValueT> &&
+                                      (std::is_copy_assignable_v<ElementT> || std::is_move_assignable_v<ElementT>);
+
+    Container * container;
+    bool writable;
+
+    ContainerView(Container & container, bool writable = false) :
+        container(&container),
+        writable(writable)
+    {}
+
+
+private:
+
+    enum InternalFields {
+        ContainerField,
+        WritableField,
+        OwnerField,
+        InternalFieldCount
+    };
+
+    // template for view objects for this container type, per isolate
+    static inline MapT<v8::Isolate *, v8::Global<v8::ObjectTemplate>> object_templates;
+
+    static Container & get_container(v8::Local<v8::Object> self) {
+        return *static_cast<Container *>(v8::Local<v8::External>::Cast(self->GetInternalField(ContainerField))->Value());
+    }
+
+    static bool is_writable(v8::Local<v8::Object> self) {
+        return self->GetInternalField(WritableField)->IsTrue();
+    }
+
+    static v8::Local<v8::Value> get_element(v8::Isolate * isolate, Container & container, uint32_t index) {
+        if constexpr(is_wrapped_type_v<ElementT>) {
+            // the JavaScript object refers to the element in the container, it doesn't own it
+            return CastToJS<std::add_lvalue_reference_t<ValueT>>()(isolate, container[index]);
+        } else {
+            // copy to handle containers which return proxy objects, like std::vector<bool>
+            return CastToJS<ElementT>()(isolate, ElementT(container[index]));
+        }
+    }
+
+
+    static void indexed_getter(uint32_t index, v8::PropertyCallbackInfo<v8::Value> const & info) {
+        auto isolate = info.GetIsolate();
+        auto & container = get_container(info.Holder());
+        if (index >= container.size()) {
+            return;
+        }
+        try {
+            info.GetReturnValue().Set(get_element(isolate, container, index));
+        } catch (std::exception & e) {
+            V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception reading element {} of container view: {}", index, e.what());
+            isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+        }
+    }
+
+
+    static void indexed_setter(uint32_t index, v8::Local<v8::Value> value, v8::PropertyCallbackInfo<v8::Value> const & info) {
+        auto isolate = info.GetIsolate();
+
+        // always intercept so the view never gets properties of its own
+        info.GetReturnValue().Set(value);
+
+        if (!is_writable(info.Holder())) {
+            return;
+        }
+        if constexpr(can_write) {
+            auto & container = get_container(info.Holder());
+            try {
+                if (index >= container.size()) {
+                    throw InvalidCallException(fmt::format("Cannot write index {} of container view with length {}", index, container.size()));
+                }
+                container[index] = CastToNative<ElementT>()(isolate, value);
+            } catch (std::exception & e) {
+                V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception writing element {} of container view: {}", index, e.what());
+                isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+            }
+        }
+    }
+
+
+    static void indexed_query(uint32_t index, v8::PropertyCallbackInfo<v8::Integer> const & info) {
+        if (index < get_container(info.Holder()).size()) {
+            auto attributes = can_write && is_writable(info.Holder()) ? v8::None : v8::ReadOnly;
+            info.GetReturnValue().Set(static_cast<int32_t>(attributes | v8::DontDelete));
+        }
+    }
+
+
+    static void indexed_deleter(uint32_t index, v8::PropertyCallbackInfo<v8::Boolean> const & info) {
+        info.GetReturnValue().Set(false);
+    }
+
+
+    static void indexed_enumerator(v8::PropertyCallbackInfo<v8::Array> const & info) {
+        auto isolate = info.GetIsolate();
+        auto context = isolate->GetCurrentContext();
+        auto size = get_container(info.Holder()).size();
+        auto indexes = v8::Array::New(isolate, static_cast<int>(size));
+        for (uint32_t i = 0; i < size; i++) {
+            (void)indexes->Set(context, i, v8::Integer::NewFromUnsigned(isolate, i));
+        }
+        info.GetReturnValue().Set(indexes);
+    }
+
+
+    static void length_getter(v8::Local<v8::Name> property, v8::PropertyCallbackInfo<v8::Value> const & info) {
+        info.GetReturnValue().Set(static_cast<double>(get_container(info.Holder()).size()));
+    }
+
+
+    static v8::Local<v8::ObjectTemplate> get_object_template(v8::Isolate * isolate) {
+        auto existing = object_templates.find(isolate);
+        if (existing != object_templates.end()) {
+            return existing->second.Get(isolate);
+        }
+
+        auto object_template = v8::ObjectTemplate::New(isolate);
+        object_template->SetInternalFieldCount(InternalFieldCount);
+        object_template->SetHandler(v8::IndexedPropertyHandlerConfiguration(
+            indexed_getter, indexed_setter, indexed_query, indexed_deleter, indexed_enumerator));
+        object_template->SetAccessor(v8::String::NewFromUtf8(isolate, "length"), length_getter, nullptr,
+                                     v8::Local<v8::Value>(), v8::DEFAULT,
+                                     static_cast<v8::PropertyAttribute>(v8::ReadOnly | v8::DontEnum | v8::DontDelete));
+
+        // array-like, so the built-in array iterator works on it
+        object_template->SetIntrinsicDataProperty(v8::Symbol::GetIterator(isolate), v8::kArrayProto_values, v8::DontEnum);
+
+        object_templates[isolate].Reset(isolate, object_template);
+        wrapper_registery.add_callback(isolate, [isolate] {
+            object_templates.erase(isolate);
+        });
+        return object_template;
+    }
+
+
+public:
+
+    /**
+     * Creates a JavaScript object viewing the container
+     * @param isolate isolate to create the object in
+     * @param owner if specified, kept alive as long as the view is alive
+     */
+    v8::Local<v8::Object> make_js_object(v8::Isolate * isolate, v8::Local<v8::Object> owner = v8::Local<v8::Object>()) const {
+        auto context = isolate->GetCurrentContext();
+        auto object = get_object_template(isolate)->NewInstance(context).ToLocalChecked();
+        object->SetInternalField(ContainerField, v8::External::New(isolate, const_cast<std::remove_cv_t<Container> *>(this->container)));
+        object->SetInternalField(WritableField, v8::Boolean::New(isolate, can_write && this->writable));
+        object->SetInternalField(OwnerField, owner.IsEmpty() ? v8::Local<v8::Value>(v8::Undefined(isolate)) : v8::Local<v8::Value>(owner));
+        return object;
+    }
+};
+
+
+template<typename T, typename Behavior>
+struct CastToJS<T, Behavior, std::enable_if_t<xl::is_template_for_v<ContainerView, T>>> {
+    v8::Local<v8::Value> operator()(v8::Isolate * isolate, std::remove_reference_t<T> const & view) const {
+        return view.make_js_object(isolate);
+    }
+};
+
+
+} // end namespace v8toolkit
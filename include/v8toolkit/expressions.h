@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <v8.h>
+
+#include "cast_to_js_impl.h"
+#include "cast_to_native_impl.h"
+#include "exceptions.h"
+#include "internalized_strings.h"
+#include "v8helpers.h"
+
+namespace v8toolkit {
+
+
+/**
+ * Per-isolate cache of JavaScript expressions compiled into functions taking named parameters, so an expression
+ * evaluated over and over is only compiled once.  Entries are keyed by expression source, parameter names and
+ * context, and the least recently used entry is dropped once the cache is full.
+ *
+ * Expressions are compiled with ScriptCompiler::CompileFunctionInContext, so unlike Context::run nothing is added
+ * to the context's list of scripts.
+ *
+ * Cached functions keep their context alive until they're dropped; v8toolkit::Context drops them when it's shut
+ * down or destroyed, otherwise call `forget_context` directly.  Stored in the isolate's data slot IsolateDataSlot.  Isolates managed through
+ * v8toolkit::Isolate release it automatically; otherwise call `release` before disposing of the isolate.
+ */
+class ExpressionCache {
+public:
+    static constexpr uint32_t IsolateDataSlot = 2;
+    static constexpr size_t DefaultCapacity = 1024;
+
+private:
+    struct Entry {
+        std::string source;
+        std::vector<std::string> parameter_names;
+        v8::Global<v8::Context> context;
+        v8::Global<v8::Function> function;
+    };
+    using Entries = std::list<Entry>;
+
+    v8::Isolate * isolate;
+    size_t capacity = DefaultCapacity;
+
+    // most recently used first
+    Entries entries;
+
+    // entries by source, the key refers to the source of one of the entries in its list
+    std::unordered_map<std::string_view, std::vector<Entries::iterator>> entries_by_source;
+
+    explicit ExpressionCache(v8::Isolate * isolate) : isolate(isolate) {}
+
+
+    static bool same_parameter_names(std::vector<std::string> const & names, std::initializer_list<std::string_view> other_names) {
+        return names.size() == other_names.size() && std::equal(names.begin(), names.end(), other_names.begin());
+    }
+
+
+    void erase(Entries::iterator entry) {
+        auto by_source = this->entries_by_source.find(entry->source);
+        auto & same_source = by_source->second;
+        same_source.erase(std::find(same_source.begin(), same_source.end(), entry));
+
+        if (same_source.empty()) {
+            this->entries_by_source.erase(by_source);
+        } else if (by_source->first.data() == entry->source.data()) {
+            // the key can't keep referring to the source being erased
+            auto node = this->entries_by_source.extract(by_source);
+            node.key() = same_source.front()->source;
+            this->entries_by_source.insert(std::move(node));
+        }
+        this->entries.erase(entry);
+    }
+
+
+    void shrink_to(size_t size) {
+        while (this->entries.size() > size) {
+            this->erase(std::prev(this->entries.end()));
+        }
+    }
+
+
+public:
+    ExpressionCache(ExpressionCache const &) = delete;
+    ExpressionCache & operator=(ExpressionCache const &) = delete;
+
+
+    /**
+     * Returns the cache for the given isolate, creating it if necessary
+     */
+    static ExpressionCache & get(v8::Isolate * isolate) {
+        auto cache = static_cast<ExpressionCache *>(isolate->GetData(IsolateDataSlot));
+        if (cache == nullptr) {
+            cache = new ExpressionCache(isolate);
+            isolate->SetData(IsolateDataSlot, cache);
+        }
+        return *cache;
+    }
+
+
+    /**
+     * Returns the cache for the given isolate or nullptr if it doesn't have one
+     */
+    static ExpressionCache * find(v8::Isolate * isolate) {
+        return static_cast<ExpressionCache *>(isolate->GetData(IsolateDataSlot));
+    }
+
+
+    /**
+     * Destroys the cache for the given isolate, if it has one
+     */
+    static void release(v8::Isolate * isolate) {
+        delete find(isolate);
+        isolate->SetData(IsolateDataSlot, nullptr);
+    }
+
+
+    /**
+     * Sets the maximum number of compiled expressions kept, dropping the least recently used ones if there are more
+     */
+    void set_capacity(size_t capacity) {
+        this->capacity = std::max<size_t>(capacity, 1);
+        this->shrink_to(this->capacity);
+    }
+
+    size_t size() const {
+        return this->entries.size();
+    }
+
+    void clear() {
+        this->shrink_to(0);
+    }
+
+
+    /**
+     * Drops all expressions compiled for the given context
+     */
+    void forget_context(v8::Local<v8::Context> context) {
+        for (auto entry = this->entries.begin(); entry != this->entries.end();) {
+            auto next = std::next(entry);
+            if (entry->context == context) {
+                this->erase(entry);
+            }
+            entry = next;
+        }
+    }
+
+
+    /**
+     * Returns the function evaluating `expression` with the given parameter names in scope, compiling it if it
+     * isn't already cached
+     * Throws V8CompilationException if the expression doesn't compile
+     */
+    v8::Local<v8::Function> get_function(v8::Local<v8::Context> context,
+                                         std::string_view expression,
+                                         std::initializer_list<std::string_view> parameter_names) {
+        v8::TryCatch try_catch(this->isolate);
+        auto function = this->find_or_compile(context, expression, parameter_names, false);
+        if (function.IsEmpty()) {
+            throw V8CompilationException(this->isolate, try_catch);
+        }
+        return function;
+    }
+
+
+    /**
+     * Like get_function, but returns an empty handle if `expression` doesn't compile, for source which may be a
+     * statement instead.  That's cached as well, so it's only compiled once either way.
+     */
+    v8::Local<v8::Function> get_function_if_expression(v8::Local<v8::Context> context,
+                                                       std::string_view expression,
+                                                       std::initializer_list<std::string_view> parameter_names) {
+        v8::TryCatch try_catch(this->isolate);
+        return this->find_or_compile(context, expression, parameter_names, true);
+    }
+
+
+private:
+
+    // entries for source that didn't compile have an empty function and are only kept if `cache_failure` is set
+    v8::Local<v8::Function> find_or_compile(v8::Local<v8::Context> context,
+                                            std::string_view expression,
+                                            std::initializer_list<std::string_view> parameter_names,
+                                            bool cache_failure) {
+
+        auto by_source = this->entries_by_source.find(expression);
+        if (by_source != this->entries_by_source.end()) {
+            for (auto entry : by_source->second) {
+                if (entry->context == context && same_parameter_names(entry->parameter_names, parameter_names)) {
+                    if (entry->function.IsEmpty() && !cache_failure) {
+                        // compile it again for the error
+                        break;
+                    }
+                    this->entries.splice(this->entries.begin(), this->entries, entry);
+                    return entry->function.Get(this->isolate);
+                }
+            }
+        }
+
+        auto body = fmt::format("return ({}\n);", expression);
+        v8::ScriptCompiler::Source source(v8::String::NewFromUtf8(this->isolate, body.data(), v8::NewStringType::kNormal,
+                                                                  static_cast<int>(body.length())).ToLocalChecked());
+        std::vector<v8::Local<v8::String>> js_parameter_names;
+        js_parameter_names.reserve(parameter_names.size());
+        for (auto name : parameter_names) {
+            js_parameter_names.push_back(make_js_key(this->isolate, name));
+        }
+
+        v8::Local<v8::Function> function;
+        if (!v8::ScriptCompiler::CompileFunctionInContext(context, &source,
+                                                          js_parameter_names.size(), js_parameter_names.data(),
+                                                          0, nullptr).ToLocal(&function) && !cache_failure) {
+            return {};
+        }
+
+        this->shrink_to(this->capacity - 1);
+        auto & entry = this->entries.emplace_front(Entry{std::string(expression),
+                                                         std::vector<std::string>(parameter_names.begin(), parameter_names.end()),
+                                                         v8::Global<v8::Context>(this->isolate, context),
+                                                         v8::Global<v8::Function>(this->isolate, function)});
+        this->entries_by_source[entry.source].push_back(this->entries.begin());
+
+        return function;
+    }
+};
+
+
+/**
+ * Evaluates a JavaScript expression with the given values bound to the given parameter names, compiling the
+ * expression only the first time it's seen - see ExpressionCache
+ *
+ *   bool matches = evaluate_expression<bool>(context, "score > limit", {"score", "limit"}, player.score, 100);
+ *
+ * Throws V8CompilationException if the expression doesn't compile and V8ExecutionException if it throws
+ */
+template<class R, class... Args>
+R evaluate_expression(v8::Local<v8::Context> context,
+                      std::string_view expression,
+                      std::initializer_list<std::string_view> parameter_names,
+                      Args && ... args) {
+    auto isolate = context->GetIsolate();
+    if (parameter_names.size() != sizeof...(Args)) {
+        throw InvalidCallException(fmt::format("Expression '{}' given {} parameter names but {} values",
+                                               expression, parameter_names.size(), sizeof...(Args)));
+    }
+
+    auto function = ExpressionCache::get(isolate).get_function(context, expression, parameter_names);
+
+    std::array<v8::Local<v8::Value>, sizeof...(Args)> parameters{{CastToJS<Args>()(isolate, std::forward<Args>(args))...}};
+
+    v8::TryCatch try_catch(isolate);
+    auto maybe_result = function->Call(context, context->Global(), static_cast<int>(parameters.size()), parameters.data());
+    if (try_catch.HasCaught() || maybe_result.IsEmpty()) {
+        throw V8ExecutionException(isolate, try_catch);
+    }
+    return CastToNative<R>()(isolate, maybe_result.ToLocalChecked());
+}
+
+
+} // end namespace v8toolkit
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <v8.h>
+
+namespace v8toolkit {
+
+
+/**
+ * Identifies a string literal at compile time so its JavaScript string can be found by index instead of by hashing
+ * its contents.  Create with V8TOOLKIT_STRING_KEY("literal")
+ */
+template<class Literal>
+struct StringKey {
+    static constexpr std::string_view value() {
+        return Literal::value();
+    }
+};
+
+#define V8TOOLKIT_STRING_KEY(literal) \
+    ([]{ struct Literal { static constexpr std::string_view value() { return literal; } }; \
+         return ::v8toolkit::StringKey<Literal>(); }())
+
+
+/**
+ * Per-isolate cache of internalized JavaScript strings for property and method names.  Property lookups with
+ * internalized keys take V8's fast paths, and a cached key doesn't allocate a new JavaScript string on every use.
+ *
+ * The strings are held in v8::Eternal handles, which live as long as the isolate, so only a bounded number of
+ * distinct names are cached.  Names beyond that are still internalized, just not cached.
+ *
+ * Stored in the isolate's data slot IsolateDataSlot.  Isolates managed through v8toolkit::Isolate release it
+ * automatically; otherwise call `release` before disposing of the isolate.
+ */
+class InternalizedStrings {
+public:
+    static constexpr uint32_t IsolateDataSlot = 1;
+    static constexpr size_t MaximumCachedNames = 4096;
+
+private:
+    v8::Isolate * isolate;
+
+    // stable storage for the names the map's keys refer to
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, v8::Eternal<v8::String>> strings;
+
+    // indexed by StringKey literal index
+    std::vector<v8::Eternal<v8::String>> literal_strings;
+
+    static inline std::atomic<size_t> next_literal_index{0};
+
+    template<class Literal>
+    static inline size_t const literal_index = next_literal_index++;
+
+    explicit InternalizedStrings(v8::Isolate * isolate) : isolate(isolate) {}
+
+    v8::Local<v8::String> create(std::string_view name) {
+        return v8::String::NewFromUtf8(this->isolate, name.data(), v8::NewStringType::kInternalized,
+                                       static_cast<int>(name.length())).ToLocalChecked();
+    }
+
+public:
+    InternalizedStrings(InternalizedStrings const &) = delete;
+    InternalizedStrings & operator=(InternalizedStrings const &) = delete;
+
+
+    /**
+     * Returns the cache for the given isolate, creating it if necessary
+     */
+    static InternalizedStrings & get(v8::Isolate * isolate) {
+        auto strings = static_cast<InternalizedStrings *>(isolate->GetData(IsolateDataSlot));
+        if (strings == nullptr) {
+            strings = new InternalizedStrings(isolate);
+            isolate->SetData(IsolateDataSlot, strings);
+        }
+        return *strings;
+    }
+
+
+    /**
+     * Destroys the cache for the given isolate, if it has one
+     */
+    static void release(v8::Isolate * isolate) {
+        delete static_cast<InternalizedStrings *>(isolate->GetData(IsolateDataSlot));
+        isolate->SetData(IsolateDataSlot, nullptr);
+    }
+
+
+    v8::Local<v8::String> get(std::string_view name) {
+        auto found = this->strings.find(name);
+        if (found != this->strings.end()) {
+            return found->second.Get(this->isolate);
+        }
+
+        auto string = this->create(name);
+        if (this->names.size() < MaximumCachedNames) {
+            auto & stored_name = this->names.emplace_back(name);
+            this->strings.emplace(stored_name, v8::Eternal<v8::String>(this->isolate, string));
+        }
+        return string;
+    }
+
+
+    template<class Literal>
+    v8::Local<v8::String> get(StringKey<Literal>) {
+        auto index = literal_index<Literal>;
+        if (index >= this->literal_strings.size()) {
+            this->literal_strings.resize(index + 1);
+        }
+        auto & eternal = this->literal_strings[index];
+        if (eternal.IsEmpty()) {
+            eternal.Set(this->isolate, this->create(Literal::value()));
+        }
+        return eternal.Get(this->isolate);
+    }
+};
+
+
+/**
+ * Returns the internalized JavaScript string for a property or method name, from the isolate's cache when possible
+ */
+inline v8::Local<v8::String> make_js_key(v8::Isolate * isolate, std::string_view name) {
+    return InternalizedStrings::get(isolate).get(name);
+}
+
+template<class Literal>
+v8::Local<v8::String> make_js_key(v8::Isolate * isolate, StringKey<Literal> key) {
+    return InternalizedStrings::get(isolate).get(key);
+}
+
+
+} // end namespace v8toolkit
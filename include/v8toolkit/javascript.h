@@ -11,6 +11,7 @@
 
 
 #include "v8_class_wrapper.h"
+#include "expressions.h"
 
 //#define V8TOOLKIT_JAVASCRIPT_DEBUG
 
@@ -57,6 +58,12 @@ private:
 	/// The actual v8::Context object backing this Context
 	v8::Global<v8::Context> context;
 
+	/// If enabled, owns all C++ objects created from JavaScript in this context
+	std::unique_ptr<ObjectArena> object_arena;
+
+	/// drops the expressions compiled for this context from the isolate's ExpressionCache, as they keep it alive
+	void forget_cached_expressions();
+
 
 
 	/// unique identifier for each context
@@ -72,12 +79,27 @@ public:
 	
 
     /**
-     * Allows for possible destruction of the Context once all Script objects are released.  This clears out
-     * all internal references to scripts to stop any circular references.  The context will have diminished
-     * functionality after shutdown is called on it.
+     * Releases what this Context holds on to beyond the v8::Context itself: destroys the objects in its
+     * ObjectArena, if enable_object_arena was called, and drops any expressions compiled for it from the
+     * isolate's ExpressionCache.  Objects created from JavaScript in an arena can't be used after this.
      */
     void shutdown();
 
+	/**
+	 * Opts this context in to having C++ objects created from JavaScript (`new SomeWrappedClass()`) owned by
+	 * an ObjectArena instead of the garbage collector.  They are bump-allocated and all destroyed together when
+	 * the context is shut down or destroyed, and their weak callbacks are skipped.  Only for objects which are not
+	 * needed after the context is done being used.  JavaScript objects which outlive the arena throw
+	 * when used as their C++ type.
+	 * @param chunk_size number of bytes the arena allocates at a time
+	 */
+	void enable_object_arena(size_t chunk_size = 64 * 1024);
+
+	/**
+	 * Returns the ObjectArena for this context or nullptr if enable_object_arena hasn't been called
+	 */
+	ObjectArena * get_object_arena() const;
+
 	/**
 	 * Returns all the scripts associated with this context
 	 * @return a vector of all the scripts associated with this context
@@ -172,6 +194,17 @@ public:
 	v8::Global<v8::Value> run(const v8::Local<v8::Value> script);
 	
 	v8::Global<v8::Value> run_from_file(const std::string & filename);
+
+	/**
+	 * Evaluates a JavaScript expression with the given values bound to the given parameter names.  The expression
+	 * is compiled the first time it's seen and cached per isolate, and nothing is added to this context's scripts.
+	 * See v8toolkit::evaluate_expression
+	 */
+	template<class R, class... Args>
+	R evaluate(std::string_view expression, std::initializer_list<std::string_view> parameter_names, Args && ... args) {
+		GLOBAL_CONTEXT_SCOPED_RUN(isolate, context);
+		return evaluate_expression<R>(this->get_context(), expression, parameter_names, std::forward<Args>(args)...);
+	}
     
 	/**
     * Compiles and runs the contents of the passed in string in a std::async and returns
@@ -550,6 +583,21 @@ public:
 	* Returns the v8::ObjectTemplate used to create contexts from this Isolate
 	*/
 	v8::Local<v8::ObjectTemplate> get_object_template();
+
+	/**
+	 * Returns the call metrics for every native function, method, accessor, and constructor exposed in this isolate.
+	 * Nothing is recorded until `set_enabled(true)` is called on it.
+	 */
+	CallMetricsRegistry & get_call_metrics() {
+		return CallMetricsRegistry::get(this->isolate);
+	}
+
+	/**
+	 * Returns the live wrapped object census for every wrapped class used in this isolate
+	 */
+	std::vector<WrappedObjectCensus> get_wrapped_object_census() {
+		return wrapper_registery.get_census(this->isolate);
+	}
 	
 	
 	/**
@@ -558,15 +606,15 @@ public:
 	template<class Callable>
 	auto operator()(Callable && callable) -> std::result_of_t<Callable()>
 	{
-		log.info(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Creating isolate scopes");
+		V8TOOLKIT_LOG_INFO(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Creating isolate scopes");
 	    ISOLATE_SCOPED_RUN(isolate);
 		if constexpr(std::is_same_v<void, std::result_of_t<Callable()>>) {
 			callable();
-			log.info(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Deleting isolate scopes");
+			V8TOOLKIT_LOG_INFO(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Deleting isolate scopes");
 			return;
 		} else {
 			auto && result = callable();
-			log.info(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Deleting isolate scopes");
+			V8TOOLKIT_LOG_INFO(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "Deleting isolate scopes");
 			return std::forward<decltype(result)>(result);
 		}
 	}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <type_traits>
+
+#include <v8.h>
+
+#include "cast_to_js_impl.h"
+#include "cast_to_native_impl.h"
+#include "exceptions.h"
+#include "v8helpers.h"
+
+namespace v8toolkit {
+
+
+template<class Signature>
+class JSFunction;
+
+
+/**
+ * Handle to a JavaScript function for calling it from C++ many times, with the parameter and return types fixed
+ * at compile time.  The function, receiver and context are looked up once and held in v8::Globals, arguments are
+ * converted into an array on the stack and the result is converted with CastToNative<R>.
+ *
+ *   JSFunction<int(std::string const &)> on_event(isolate, context, callback);
+ *   int handled = on_event("click");
+ *
+ * Use `call_in_scope` instead of operator() when the caller already holds the isolate's Locker and is inside a
+ * HandleScope and the function's context, to skip setting them up for every call.
+ *
+ * Moveable but not copyable, like the v8::Globals it holds.
+ */
+template<class R, class... Args>
+class JSFunction<R(Args...)> {
+    v8::Isolate * isolate = nullptr;
+    v8::Global<v8::Context> context;
+    v8::Global<v8::Function> function;
+    v8::Global<v8::Value> receiver;
+
+public:
+    JSFunction() = default;
+    JSFunction(JSFunction &&) = default;
+    JSFunction & operator=(JSFunction &&) = default;
+
+
+    /**
+     * @param receiver `this` inside the function, the context's global object if empty
+     */
+    JSFunction(v8::Isolate * isolate,
+               v8::Local<v8::Context> context,
+               v8::Local<v8::Function> function,
+               v8::Local<v8::Value> receiver = v8::Local<v8::Value>()) :
+        isolate(isolate),
+        context(isolate, context),
+        function(isolate, function),
+        receiver(isolate, receiver.IsEmpty() ? v8::Local<v8::Value>(context->Global()) : receiver)
+    {}
+
+
+    /**
+     * Looks up the method named `method_name` on `object` once, to be called later with `object` as its receiver
+     */
+    static JSFunction from_method(v8::Local<v8::Context> context, v8::Local<v8::Object> object, std::string_view method_name) {
+        auto isolate = context->GetIsolate();
+        v8::Local<v8::Value> value;
+        if (!object->Get(context, make_js_key(isolate, method_name)).ToLocal(&value) || !value->IsFunction()) {
+            throw InvalidCallException(fmt::format("receiver doesn't have a function property named: {}", method_name));
+        }
+        return JSFunction(isolate, context, v8::Local<v8::Function>::Cast(value), object);
+    }
+
+
+    bool empty() const {
+        return this->function.IsEmpty();
+    }
+
+
+    /**
+     * Calls the function, taking the isolate's Locker and entering its context
+     */
+    R operator()(Args... args) const {
+        v8::Locker locker(this->isolate);
+        v8::Isolate::Scope isolate_scope(this->isolate);
+        v8::HandleScope handle_scope(this->isolate);
+        v8::Context::Scope context_scope(this->context.Get(this->isolate));
+        return this->call_in_scope(std::forward<Args>(args)...);
+    }
+
+
+    /**
+     * Calls the function without any Locker or scope setup - the caller must already hold the Locker and be inside a
+     * HandleScope and the function's context.  Handles created by the call belong to the caller's HandleScope.
+     */
+    R call_in_scope(Args... args) const {
+        auto isolate = this->isolate;
+        auto context = this->context.Get(isolate);
+
+        std::array<v8::Local<v8::Value>, sizeof...(Args)> parameters{{CastToJS<Args>()(isolate, std::forward<Args>(args))...}};
+
+        v8::TryCatch tc(isolate);
+        auto maybe_result = this->function.Get(isolate)->Call(context, this->receiver.Get(isolate),
+                                                               static_cast<int>(parameters.size()), parameters.data());
+        if (tc.HasCaught() || maybe_result.IsEmpty()) {
+            ReportException(isolate, &tc);
+            throw V8ExecutionException(isolate, tc);
+        }
+
+        if constexpr(!std::is_void_v<R>) {
+            return CastToNative<R>()(isolate, maybe_result.ToLocalChecked());
+        }
+    }
+};
+
+
+/**
+ * A native function taking a JSFunction gets the JavaScript function it's called with, with the current context's
+ * global object as its receiver
+ */
+template<class R, class... Args, typename Behavior>
+struct CastToNative<JSFunction<R(Args...)>, Behavior> {
+    JSFunction<R(Args...)> operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        return JSFunction<R(Args...)>(isolate, isolate->GetCurrentContext(), get_value_as<v8::Function>(isolate, value));
+    }
+};
+
+
+} // end namespace v8toolkit
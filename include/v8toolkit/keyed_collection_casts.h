@@ -0,0 +1,143 @@
+#pragma once
+
+#include <type_traits>
+
+#include <v8.h>
+
+#include "v8_class_wrapper.h"
+
+namespace v8toolkit {
+
+
+/**
+ * CastToJS used by CastToJSKeyedCollectionsBehavior.  Map-like containers become a JavaScript Map and set-like
+ * containers become a JavaScript Set, with keys converted as their own type instead of as property names, so integer
+ * keys stay numbers.  Containers with duplicate keys map each key to an array of its values.  Everything else is
+ * cast exactly as CastToJS would.
+ */
+template<typename T, typename Behavior, typename = void>
+struct CastToJSKeyedCollections : CastToJS<T, Behavior> {};
+
+
+template<typename T, typename Behavior>
+struct CastToJSKeyedCollections<T, Behavior, std::enable_if_t<acts_like_map_v<T>>> {
+    using NoRefT = std::remove_reference_t<T>;
+    using KeyT = typename std::remove_cv_t<NoRefT>::key_type;
+    using ValueT = typename std::remove_cv_t<NoRefT>::mapped_type;
+
+    v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT const & map) const {
+        if constexpr(!has_unique_keys_v<NoRefT>) {
+            return casttojs_multimaplike<Behavior>(isolate, map);
+        } else {
+            auto context = isolate->GetCurrentContext();
+            auto js_map = v8::Map::New(isolate);
+            for (auto & pair : map) {
+                (void)js_map->Set(context,
+                                  Behavior()(static_cast<KeyT const &>(pair.first)),
+                                  Behavior()(static_cast<ValueT const &>(pair.second)));
+            }
+            return js_map;
+        }
+    }
+};
+
+
+template<typename T, typename Behavior>
+struct CastToJSKeyedCollections<T, Behavior, std::enable_if_t<acts_like_set_v<T>>> {
+    using NoRefT = std::remove_reference_t<T>;
+    using KeyT = typename std::remove_cv_t<NoRefT>::key_type;
+
+    v8::Local<v8::Value> operator()(v8::Isolate * isolate, NoRefT const & set) const {
+        auto context = isolate->GetCurrentContext();
+        auto js_set = v8::Set::New(isolate);
+        for (auto & key : set) {
+            (void)js_set->Add(context, Behavior()(static_cast<KeyT const &>(key)));
+        }
+        return js_set;
+    }
+};
+
+
+/**
+ * CastToNative used by CastToNativeKeyedCollectionsBehavior.  A JavaScript Map or Set is read in a single AsArray()
+ * call and its keys are converted from whatever type they are, so a Map with number keys fills a std::map<int, ...>
+ * directly.  Each Map value is converted as a whole to the mapped type, so a std::map<int, std::vector<int>> gets
+ * one vector per key; only containers with duplicate keys treat an array value as a list of values for its key.
+ * Other JavaScript values, like plain objects and arrays, are cast exactly as CastToNative would.
+ */
+template<typename T, typename Behavior, typename = void>
+struct CastToNativeKeyedCollections : CastToNative<T, Behavior> {};
+
+
+template<typename T, typename Behavior>
+struct CastToNativeKeyedCollections<T, Behavior, std::enable_if_t<acts_like_map_v<T>>> {
+    using NonConstT = std::remove_const_t<T>;
+    using KeyT = typename NonConstT::key_type;
+    using ValueT = typename NonConstT::mapped_type;
+
+    T operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        if (!value->IsMap()) {
+            return CastToNative<T, Behavior>()(isolate, value);
+        }
+
+        auto context = isolate->GetCurrentContext();
+        auto entries = v8::Local<v8::Map>::Cast(value)->AsArray();
+        uint32_t length = entries->Length();
+
+        NonConstT results;
+        for (uint32_t i = 0; i + 1 < length; i += 2) {
+            auto key = Behavior().template operator()<KeyT>(entries->Get(context, i).ToLocalChecked());
+            auto entry_value = entries->Get(context, i + 1).ToLocalChecked();
+            if constexpr(has_unique_keys_v<NonConstT>) {
+                results.emplace(std::move(key), Behavior().template operator()<ValueT>(entry_value));
+            } else {
+                for_each_value(entry_value, [&](v8::Local<v8::Value> element) {
+                    results.emplace(key, Behavior().template operator()<ValueT>(element));
+                });
+            }
+        }
+        return results;
+    }
+    static constexpr bool callable(){return true;}
+};
+
+
+template<typename T, typename Behavior>
+struct CastToNativeKeyedCollections<T, Behavior, std::enable_if_t<acts_like_set_v<T>>> {
+    using NonConstT = std::remove_const_t<T>;
+    using KeyT = typename NonConstT::key_type;
+
+    T operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) const {
+        if (!value->IsSet()) {
+            return CastToNative<T, Behavior>()(isolate, value);
+        }
+
+        auto context = isolate->GetCurrentContext();
+        auto keys = v8::Local<v8::Set>::Cast(value)->AsArray();
+        uint32_t length = keys->Length();
+
+        NonConstT results;
+        for (uint32_t i = 0; i < length; i++) {
+            results.emplace(Behavior().template operator()<KeyT>(keys->Get(context, i).ToLocalChecked()));
+        }
+        return results;
+    }
+    static constexpr bool callable(){return true;}
+};
+
+
+/**
+ * Opt-in behaviors converting C++ associative containers to and from JavaScript Map and Set objects instead of
+ * arrays and plain objects.  Nested containers are converted the same way.
+ *
+ * auto js_value = CastToJSKeyedCollectionsBehavior()(lookup_table);
+ * auto lookup_table = CastToNativeKeyedCollectionsBehavior().operator()<std::map<int, std::string>>(js_value);
+ */
+struct CastToJSKeyedCollectionsBehavior :
+    CastToJSBehaviorBase<CastToJSKeyedCollectionsBehavior, CastToJSKeyedCollections> {};
+
+struct CastToNativeKeyedCollectionsBehavior :
+    CastToNativeBehaviorBase<CastToNativeKeyedCollectionsBehavior, CastToNativeKeyedCollections> {};
+
+
+} // end namespace v8toolkit
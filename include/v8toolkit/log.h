@@ -35,4 +35,47 @@ struct LoggingSubjects {
 using LogT = xl::log::Log<xl::log::DefaultLevels, LoggingSubjects>;
 inline LogT log;
 
-} // end namespace v8toolkit
\ No newline at end of file
+
+/**
+ * Bitmask of subjects for which logging statements using the V8TOOLKIT_LOG macros are compiled in at all.  Bit N
+ * corresponds to LoggingSubjects::Subjects value N.  Define before including any v8toolkit headers to compile
+ * out subjects, e.g. to drop everything but exceptions:
+ *   -DV8TOOLKIT_LOG_COMPILED_SUBJECTS="((1<<1) | (1<<2))"
+ */
+#ifndef V8TOOLKIT_LOG_COMPILED_SUBJECTS
+#define V8TOOLKIT_LOG_COMPILED_SUBJECTS (~0ull)
+#endif
+
+constexpr bool log_subject_compiled(LoggingSubjects::Subjects subject) {
+    return ((V8TOOLKIT_LOG_COMPILED_SUBJECTS) >> static_cast<int>(subject)) & 1;
+}
+
+
+} // end namespace v8toolkit
+
+
+#include "log_ring_buffer.h"
+
+
+/**
+ * Logs to v8toolkit::log at the given level (info, warn, error, ...) only if the subject is compiled in and
+ * enabled at runtime with v8toolkit::log.set_status.  The format string and arguments are not evaluated
+ * otherwise.  If a LogRingBuffer is installed, the message is formatted later on its background thread.
+ */
+#define V8TOOLKIT_LOG(level, subject, ...) \
+    do { \
+        if constexpr(v8toolkit::log_subject_compiled(subject)) { \
+            if (v8toolkit::log.get_status(subject)) { \
+                if (auto _v8toolkit_log_ring_buffer = v8toolkit::LogRingBuffer::get_installed()) { \
+                    _v8toolkit_log_ring_buffer->push(+[](v8toolkit::LogT::Subjects _subject, std::string const & _message){ \
+                        v8toolkit::log.level(_subject, "{}", _message); \
+                    }, subject, __VA_ARGS__); \
+                } else { \
+                    v8toolkit::log.level(subject, __VA_ARGS__); \
+                } \
+            } \
+        } \
+    } while(false)
+
+#define V8TOOLKIT_LOG_INFO(subject, ...) V8TOOLKIT_LOG(info, subject, __VA_ARGS__)
+#define V8TOOLKIT_LOG_ERROR(subject, ...) V8TOOLKIT_LOG(error, subject, __VA_ARGS__)
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "log.h"
+
+namespace v8toolkit {
+
+
+/**
+ * Log sink which copies log statement arguments into fixed-size binary records in a ring buffer and does the
+ * formatting and output on a background thread, so the logging thread only pays for the copy.
+ * Only one may be installed at a time.  Records are dropped (and counted) if the buffer is full.
+ *
+ * Arguments which are trivially copyable are stored as-is.  Strings are copied inline, truncated to
+ * InlineStringLength characters.  Anything else is formatted to a string immediately.  The format string
+ * must have static storage duration (a string literal).
+ */
+class LogRingBuffer {
+public:
+    static constexpr size_t InlineStringLength = 63;
+    static constexpr size_t ArgumentBytes = 256;
+
+    // writes an already-formatted message to the final destination at the level of the original statement
+    using EmitFunction = void(*)(LogT::Subjects, std::string const &);
+
+private:
+
+    struct InlineString {
+        unsigned char length;
+        char data[InlineStringLength];
+
+        InlineString(std::string_view string) {
+            this->length = static_cast<unsigned char>(std::min(string.size(), InlineStringLength));
+            std::memcpy(this->data, string.data(), this->length);
+        }
+    };
+
+    struct Record {
+        EmitFunction emit;
+        std::string (*format)(char const * format_string, unsigned char const * arguments);
+        char const * format_string;
+        LogT::Subjects subject;
+        alignas(std::max_align_t) unsigned char arguments[ArgumentBytes];
+    };
+
+    template<class Argument>
+    static auto make_storable(Argument && argument) {
+        using DecayedT = std::decay_t<Argument>;
+        if constexpr(std::is_convertible_v<Argument, std::string_view>) {
+            return InlineString(std::string_view(argument));
+        } else if constexpr(std::is_trivially_copyable_v<DecayedT>) {
+            return DecayedT(argument);
+        } else {
+            return InlineString(fmt::format("{}", argument));
+        }
+    }
+
+    template<class Stored>
+    static decltype(auto) make_formattable(Stored const & stored) {
+        if constexpr(std::is_same_v<Stored, InlineString>) {
+            return std::string_view(stored.data, stored.length);
+        } else {
+            return stored;
+        }
+    }
+
+    template<class Tuple>
+    static std::string format_arguments(char const * format_string, unsigned char const * arguments) {
+        auto & tuple = *reinterpret_cast<Tuple const *>(arguments);
+        return std::apply([format_string](auto const &... stored) {
+            return fmt::format(format_string, make_formattable(stored)...);
+        }, tuple);
+    }
+
+
+    std::vector<Record> records;
+    size_t head = 0; // next record to format
+    size_t count = 0; // number of records waiting
+    std::atomic<size_t> dropped{0};
+    bool stopping = false;
+
+    std::mutex mutex;
+    std::condition_variable records_available;
+    std::thread formatting_thread;
+
+    static inline std::atomic<LogRingBuffer *> installed{nullptr};
+
+
+    void run() {
+        std::vector<Record> batch;
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (true) {
+            this->records_available.wait(lock, [this]{return this->count > 0 || this->stopping;});
+            if (this->count == 0 && this->stopping) {
+                return;
+            }
+
+            // take everything currently queued and format it without holding the lock
+            batch.clear();
+            for (; this->count > 0; this->count--) {
+                batch.push_back(this->records[this->head]);
+                this->head = (this->head + 1) % this->records.size();
+            }
+            lock.unlock();
+            for (auto & record : batch) {
+                record.emit(record.subject, record.format(record.format_string, record.arguments));
+            }
+            lock.lock();
+        }
+    }
+
+
+public:
+
+    /**
+     * @param capacity maximum number of records waiting to be formatted
+     */
+    LogRingBuffer(size_t capacity = 4096) :
+        records(capacity),
+        formatting_thread([this]{this->run();})
+    {}
+
+    LogRingBuffer(LogRingBuffer const &) = delete;
+    LogRingBuffer & operator=(LogRingBuffer const &) = delete;
+
+    /**
+     * Formats any remaining records before returning
+     */
+    ~LogRingBuffer() {
+        this->uninstall();
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+        this->records_available.notify_one();
+        this->formatting_thread.join();
+    }
+
+
+    /**
+     * Routes all V8TOOLKIT_LOG statements through this ring buffer
+     */
+    void install() {
+        installed = this;
+    }
+
+    /**
+     * Stops routing V8TOOLKIT_LOG statements through this ring buffer if it is the installed one
+     */
+    void uninstall() {
+        LogRingBuffer * expected = this;
+        installed.compare_exchange_strong(expected, nullptr);
+    }
+
+    static LogRingBuffer * get_installed() {
+        return installed.load(std::memory_order_acquire);
+    }
+
+
+    /**
+     * Queues a log statement to be formatted and emitted on the background thread
+     */
+    template<class... Arguments>
+    void push(EmitFunction emit, LogT::Subjects subject, char const * format_string, Arguments &&... arguments) {
+        using Tuple = std::tuple<decltype(make_storable(std::forward<Arguments>(arguments)))...>;
+        static_assert(sizeof(Tuple) <= ArgumentBytes, "Too many or too large arguments for LogRingBuffer record");
+
+        Record record;
+        record.emit = emit;
+        record.format = &format_arguments<Tuple>;
+        record.format_string = format_string;
+        record.subject = subject;
+        new(record.arguments) Tuple(make_storable(std::forward<Arguments>(arguments))...);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (this->count == this->records.size()) {
+                this->dropped++;
+                return;
+            }
+            this->records[(this->head + this->count) % this->records.size()] = record;
+            this->count++;
+        }
+        this->records_available.notify_one();
+    }
+
+
+    /**
+     * @return number of log statements discarded because the ring buffer was full
+     */
+    size_t get_dropped_count() const {
+        return this->dropped;
+    }
+};
+
+
+} // end namespace v8toolkit
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <v8.h>
+
+#include "v8helpers.h"
+
+namespace v8toolkit {
+
+struct WrappedObjectHeader;
+
+
+/**
+ * Owns C++ objects created from JavaScript (via `new` on a wrapped class constructor) while the associated
+ * context is active.  Objects are bump-allocated out of large chunks and are never cleaned up by the garbage
+ * collector - instead they are all destroyed together, in reverse order of creation, when the arena is destroyed.
+ * Intended for objects whose lifetime is bounded by a single context, such as one context per request.
+ *
+ * Only one arena may be associated with a given context.  An arena must be destroyed before its isolate.
+ */
+class ObjectArena {
+public:
+    // called on arena destruction to disconnect a JavaScript object from its now-destroyed C++ object
+    using DetachCallback = void(*)(v8::Isolate *, WrappedObjectHeader *);
+
+private:
+
+    struct Entry {
+        void * object;
+        void (*destroy)(void *);
+        WrappedObjectHeader * wrapped_data = nullptr;
+        DetachCallback detach = nullptr;
+    };
+
+    v8::Isolate * isolate;
+    v8::Global<v8::Context> context;
+    size_t const chunk_size;
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char * next = nullptr;
+    size_t remaining = 0;
+
+    // every object created in the arena, in creation order
+    std::vector<Entry> entries;
+
+    /**
+     * All arenas in all isolates so the arena for the currently-entered context can be found.  Isolates may be
+     * used from different threads, so access is guarded, but the common case of no arenas existing at all
+     * only checks the count.
+     */
+    static inline std::vector<ObjectArena *> all_arenas;
+    static inline std::mutex all_arenas_mutex;
+    static inline std::atomic<int> arena_count{0};
+
+    template<class T>
+    static void destroy_object(void * object) {
+        static_cast<T *>(object)->~T();
+    }
+
+    void * allocate(size_t size, size_t alignment) {
+        // objects larger than a chunk get a chunk of their own
+        size_t needed = size + alignment - 1;
+        if (needed > this->remaining) {
+            size_t new_chunk_size = std::max(this->chunk_size, needed);
+            this->chunks.emplace_back(new char[new_chunk_size]);
+            this->next = this->chunks.back().get();
+            this->remaining = new_chunk_size;
+        }
+
+        void * result = this->next;
+        std::align(alignment, size, result, this->remaining);
+        this->next = static_cast<char *>(result) + size;
+        this->remaining -= size;
+        return result;
+    }
+
+public:
+
+    /**
+     * Creates an arena for objects created from JavaScript while `context` is the current context
+     * @param isolate isolate the context is in
+     * @param context context to associate the arena with
+     * @param chunk_size number of bytes allocated at a time for storing objects
+     */
+    ObjectArena(v8::Isolate * isolate, v8::Local<v8::Context> context, size_t chunk_size = 64 * 1024) :
+        isolate(isolate),
+        context(isolate, context),
+        chunk_size(chunk_size)
+    {
+        std::lock_guard<std::mutex> lock(all_arenas_mutex);
+        all_arenas.push_back(this);
+        arena_count++;
+    }
+
+    ObjectArena(ObjectArena const &) = delete;
+    ObjectArena & operator=(ObjectArena const &) = delete;
+
+    ~ObjectArena() {
+        this->destroy_all();
+
+        std::lock_guard<std::mutex> lock(all_arenas_mutex);
+        all_arenas.erase(std::remove(all_arenas.begin(), all_arenas.end(), this), all_arenas.end());
+        arena_count--;
+    }
+
+
+    /**
+     * Returns the arena associated with the isolate's current context, if any
+     * @param isolate isolate to check the current context of
+     * @return the arena or nullptr if the current context doesn't have one
+     */
+    static ObjectArena * get_active(v8::Isolate * isolate) {
+        if (arena_count == 0 || !isolate->InContext()) {
+            return nullptr;
+        }
+        auto current_context = isolate->GetCurrentContext();
+        std::lock_guard<std::mutex> lock(all_arenas_mutex);
+        for (auto arena : all_arenas) {
+            if (arena->isolate == isolate && arena->context == current_context) {
+                return arena;
+            }
+        }
+        return nullptr;
+    }
+
+
+    /**
+     * Constructs a new T inside the arena.  It will be destroyed when the arena is destroyed.
+     * @param args parameters forwarded to T's constructor
+     * @return the new object
+     */
+    template<class T, class... Args>
+    T * create(Args&&... args) {
+        void * storage = this->allocate(sizeof(T), alignof(T));
+        T * result = new(storage) T(std::forward<Args>(args)...);
+        this->entries.push_back(Entry{result, &destroy_object<T>});
+        return result;
+    }
+
+
+    /**
+     * Associates the JavaScript object data for an object previously created with `create`, so the JavaScript
+     * object can be detached when the arena is destroyed
+     */
+    void set_wrapped_data(void * object, WrappedObjectHeader * wrapped_data, DetachCallback detach) {
+        // almost always the most recently created object
+        for (auto entry = this->entries.rbegin(); entry != this->entries.rend(); entry++) {
+            if (entry->object == object) {
+                entry->wrapped_data = wrapped_data;
+                entry->detach = detach;
+                return;
+            }
+        }
+        assert(false);
+    }
+
+
+    /**
+     * Detaches all JavaScript objects and destroys all C++ objects in the arena, most recently created first,
+     * then releases all memory.  The arena may be used again afterwards.
+     */
+    void destroy_all() {
+        if (!this->entries.empty()) {
+            ISOLATE_SCOPED_RUN(this->isolate);
+            for (auto entry = this->entries.rbegin(); entry != this->entries.rend(); entry++) {
+                if (entry->detach != nullptr) {
+                    entry->detach(this->isolate, entry->wrapped_data);
+                }
+                entry->destroy(entry->object);
+            }
+        }
+        this->entries.clear();
+        this->chunks.clear();
+        this->next = nullptr;
+        this->remaining = 0;
+    }
+
+
+    /**
+     * @return the number of objects currently in the arena
+     */
+    size_t size() const {
+        return this->entries.size();
+    }
+};
+
+
+} // end namespace v8toolkit
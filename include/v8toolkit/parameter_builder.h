@@ -9,6 +9,7 @@
 
 #include "casts_impl.h"
 #include "v8helpers.h"
+#include "parameter_storage.h"
 #include "unspecified_parameter_value.h"
 
 namespace v8toolkit {
@@ -32,7 +33,8 @@ namespace v8toolkit {
  * is responsible for one parameter.
  *
  * If the parameter isn't self contained (pointers, references, and things that behave like a char*, then the memory
- * allocated for it will be stored in `stuff` which is automatically cleaned up when the function returns.
+ * allocated for it will be stored in `stuff` which is automatically cleaned up when the function returns.  Callers
+ * size `stuff` with ParameterStorageFor so those temporaries usually live on the stack.
  *
  * If no explicit parameter is provided from JavaScript, a default value may be available in `default_args_tuple`
  */
@@ -46,10 +48,10 @@ template<class T>
 struct ParameterBuilder<T const> {
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
     const T operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                   std::vector<std::unique_ptr<StuffBase>> & stuff,
+                   ParameterStorage & stuff,
                    DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder proxying const {} => {}", xl::demangle<T>(), xl::demangle<T>());
-        return ParameterBuilder<T>()(info, i, stuff, std::move(default_args_tuple));
+        return ParameterBuilder<T>().template operator()<default_arg_position>(info, i, stuff, std::move(default_args_tuple));
     }
 };
 
@@ -62,10 +64,10 @@ template <class T>
 struct ParameterBuilder<T &, std::enable_if_t<!std::is_same_v<std::remove_const_t<T>, char> && !is_wrapped_type_v<T>>> {
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
     T & operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                 std::vector<std::unique_ptr<StuffBase>> & stuff,
+                 ParameterStorage & stuff,
                  DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling lvalue reference: {}", xl::demangle<T>());
-        return * ParameterBuilder<T*>()(info, i, stuff, std::move(default_args_tuple));
+        return * ParameterBuilder<T*>().template operator()<default_arg_position>(info, i, stuff, std::move(default_args_tuple));
     }
 
 };
@@ -75,13 +77,12 @@ template <class T>
 struct ParameterBuilder<T &, std::enable_if_t<std::is_same_v<std::remove_const_t<T>, char> && !is_wrapped_type_v<T>>> {
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
     T & operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                   std::vector<std::unique_ptr<StuffBase>> & stuff,
+                   ParameterStorage & stuff,
                    DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling lvalue reference for char: {}", xl::demangle<T>());
         auto value = info[i++];
         auto isolate = info.GetIsolate();
-        stuff.push_back(std::make_unique<Stuff<char>>(std::make_unique<char>(CastToNative<char>()(isolate, value))));
-        return *static_cast<Stuff<char> &>(*stuff.back()).get();
+        return stuff.emplace<char>(CastToNative<char>()(isolate, value));
 
     }
 
@@ -93,7 +94,7 @@ struct ParameterBuilder<T &&, std::enable_if_t<!is_wrapped_type_v<T>>> {
 
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
     T && operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                   std::vector<std::unique_ptr<StuffBase>> & stuff,
+                   ParameterStorage & stuff,
                    DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 
         PB_PRINT("ParameterBuilder handling rvalue reference to unwrapped type: {}", xl::demangle<T>());
@@ -119,16 +120,15 @@ struct ParameterBuilder<T*,
     static_assert(!std::is_pointer_v<WrappedT>, "multi-pointer types not supported");
 
     template<int default_arg_position = -1, class DefaultArgsTupleRef = std::tuple<>>
-    WrappedT * operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                   std::vector<std::unique_ptr<StuffBase>> & stuff,
+    T * operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
+                   ParameterStorage & stuff,
                    DefaultArgsTupleRef && default_args_tuple = DefaultArgsTupleRef()) {
 
         PB_PRINT("ParameterBuilder handling pointers to unwrapped types: {}", xl::demangle<T>());
         if (i >= info.Length()) {
-            return get_default_parameter<WrappedT, default_arg_position>(info, i, stuff, default_args_tuple);
+            return get_default_parameter<T, default_arg_position>(info, i, stuff, default_args_tuple);
         } else {
-            stuff.push_back(Stuff<WrappedT>::stuffer(ParameterBuilder<WrappedT>().template operator()<default_arg_position>(info, i, stuff, default_args_tuple)));
-            return static_cast<Stuff<WrappedT> &>(*stuff.back()).get();
+            return &stuff.emplace<WrappedT>(ParameterBuilder<WrappedT>().template operator()<default_arg_position>(info, i, stuff, default_args_tuple));
         }
     }
 
@@ -148,14 +148,14 @@ struct ParameterBuilder<T*, std::enable_if_t<is_wrapped_type_v<T> >
 
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
     WrappedT * operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                   std::vector<std::unique_ptr<StuffBase>> & stuff,
+                   ParameterStorage & stuff,
                    DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 
         PB_PRINT("ParameterBuilder handling pointer to wrapped type: {}", xl::demangle<T>());
 
         //std::cerr << fmt::format("ParameterBuilder type: pointer-to {} default_arg_position = {}", v8toolkit::demangle<T>(), default_arg_position) << std::endl;
         if (i >= info.Length()) {
-            return *get_default_parameter<std::remove_const_t<WrappedT> *, default_arg_position>(info, i, stuff, default_args_tuple);
+            return *get_default_parameter<std::remove_const_t<WrappedT> * const, default_arg_position>(info, i, stuff, default_args_tuple);
 
         } else {
             // try to get the object from inside a javascript object, otherwise, fall back to a CastToNative<T> call
@@ -164,11 +164,9 @@ struct ParameterBuilder<T*, std::enable_if_t<is_wrapped_type_v<T> >
 
             } else if constexpr(CastToNative<WrappedT>::callable()) {
                 if constexpr(CallableWithFunctionCallbackInfo_v<WrappedT>) {
-                    stuff.push_back(Stuff<WrappedT>::stuffer(CastToNative<WrappedT>()(info.GetIsolate(), info)));
-                    return static_cast<Stuff<WrappedT> &>(*stuff.back()).get();
+                    return &stuff.emplace<std::remove_const_t<WrappedT>>(CastToNative<WrappedT>()(info.GetIsolate(), info));
                 } else {
-                    stuff.push_back(Stuff<WrappedT>::stuffer(CastToNative<WrappedT>()(info.GetIsolate(), info[i++])));
-                    return static_cast<Stuff<WrappedT> &>(*stuff.back()).get();
+                    return &stuff.emplace<std::remove_const_t<WrappedT>>(CastToNative<WrappedT>()(info.GetIsolate(), info[i++]));
                 }
             } else {
                 throw CastException("Tried to send a pointer {} to a function but the JavaScript object wasn't a wrapped "
@@ -194,7 +192,7 @@ struct ParameterBuilder<T, std::enable_if_t<
 
     template<int default_arg_position = -1, class DefaultArgsTupleRef = std::tuple<>>
     T operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-               std::vector<std::unique_ptr<StuffBase>> & stuff,
+               ParameterStorage & stuff,
                DefaultArgsTupleRef && default_args_tuple = DefaultArgsTupleRef()) {
 
         using DefaultArgsTuple = std::remove_reference_t<DefaultArgsTupleRef>;
@@ -230,7 +228,7 @@ struct ParameterBuilder<Container<char *, Rest...>, std::enable_if_t<!std::is_re
 
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     ResultType operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                          std::vector<std::unique_ptr<StuffBase>> & stuffs,
+                          ParameterStorage & stuffs,
                           DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 
         PB_PRINT("ParameterBuilder handling container of char *");
@@ -243,15 +241,11 @@ struct ParameterBuilder<Container<char *, Rest...>, std::enable_if_t<!std::is_re
                 "Not enough javascript parameters for function call - requires {} but only {} were specified",
                 i + 1 + sizeof(Rest)..., info.Length()));
         }
-        Stuff<DataHolderType> stuff(CastToNative<ResultType>()(info.GetIsolate(), info[i++]));
-        auto data_holder = stuff.get();
-
-        stuffs.emplace_back(std::move(stuff));
-
+        auto & data_holder = stuffs.emplace<DataHolderType>(CastToNative<ResultType>()(info.GetIsolate(), info[i++]));
 
         ResultType result;
         for (auto & str : data_holder) {
-            result.push_back(str->c_str());
+            result.push_back(str.get());
         }
         return result;
     }
@@ -272,18 +266,23 @@ struct ParameterBuilder<Container<char const *, Rest...>,
 
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     ResultType operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                          std::vector<std::unique_ptr<StuffBase>> & stuffs,
+                          ParameterStorage & stuffs,
                           DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 
         PB_PRINT("ParameterBuilder handling container of char const *");
 
         //std::cerr << fmt::format("parameterbuilder type: Container<char const *,...> default_arg_position = {}", default_arg_position) << std::endl;
         if (i >= info.Length()) {
-            return *get_default_parameter<ResultType, default_arg_position>(info, i, stuffs, default_args_tuple);
+            return *get_default_parameter<ResultType const, default_arg_position>(info, i, stuffs, default_args_tuple);
 
         } else {
-            stuffs.emplace_back(Stuff<ResultType>::stuffer(CastToNative<ResultType>()(info.GetIsolate(), info[i++])));
-            return *static_cast<Stuff<ResultType> &>(*stuffs.back()).get()->get();
+            auto & data_holder = stuffs.emplace<DataHolderType>(CastToNative<ResultType>()(info.GetIsolate(), info[i++]));
+
+            ResultType result;
+            for (auto & str : data_holder) {
+                result.push_back(str.get());
+            }
+            return result;
         }
     }
 
@@ -296,7 +295,7 @@ struct ParameterBuilder<T, std::enable_if_t<is_string_not_owning_memory_v<T>>> {
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     T operator()(const v8::FunctionCallbackInfo<v8::Value> & info,
                             int & i,
-                            std::vector<std::unique_ptr<StuffBase>> & stuff,
+                            ParameterStorage & stuff,
                             DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 
         PB_PRINT("ParameterBuilder handling {}", xl::demangle<T>());
@@ -305,12 +304,20 @@ struct ParameterBuilder<T, std::enable_if_t<is_string_not_owning_memory_v<T>>> {
 
         // if there is a value, use it, otherwise just use empty string
         if (i >= info.Length()) {
-            return T(*get_default_parameter<T, default_arg_position>(info, i, stuff, default_args_tuple));
+            return T(*get_default_parameter<T const, default_arg_position>(info, i, stuff, default_args_tuple));
 
         } else {
+            // a string_view can point straight at memory an external string already holds instead of at a copy.
+            //   Buffers are converted to strings like any other value - take a Span<char const> to view their bytes
+            if constexpr(std::is_same_v<T, std::string_view>) {
+                if (auto external_string = get_external_string_view(info[i])) {
+                    i++;
+                    return *external_string;
+                }
+            }
+
             auto string = CastToNative<T>()(info.GetIsolate(), info[i++]);
-            stuff.emplace_back(std::make_unique<Stuff<decltype(string)>>(std::move(string)));
-            return static_cast<Stuff<decltype(string)> &>(*stuff.back()).get()->get();
+            return stuff.emplace<decltype(string)>(std::move(string)).get();
         }
     }
 
@@ -324,7 +331,7 @@ struct ParameterBuilder<const v8::FunctionCallbackInfo<v8::Value> &> {
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     const v8::FunctionCallbackInfo<v8::Value> & operator()(const v8::FunctionCallbackInfo<v8::Value> & info,
                                                            int & i,
-                                                           std::vector<std::unique_ptr<StuffBase>> & stuff,
+                                                           ParameterStorage & stuff,
                                                            DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling v8::FunctionCallbackInfo<v8::Value> const &");
 
@@ -341,7 +348,7 @@ template<>
 struct ParameterBuilder<v8::Isolate *> {
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     v8::Isolate * operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                             std::vector<std::unique_ptr<StuffBase>> & stuff,
+                             ParameterStorage & stuff,
                              DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling v8::Isolate *");
 
@@ -358,7 +365,7 @@ template<>
 struct ParameterBuilder<v8::Local<v8::Context>> {
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     v8::Local<v8::Context> operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                                      std::vector<std::unique_ptr<StuffBase>> & stuff,
+                                      ParameterStorage & stuff,
                                       DefaultArgsTuple const & default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling v8::Local<v8::Context>");
 
@@ -384,7 +391,7 @@ struct ParameterBuilder<
 
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     v8::Local<T> operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                                     std::vector<std::unique_ptr<StuffBase>> & stuff,
+                                     ParameterStorage & stuff,
                                      DefaultArgsTuple const & default_args_tuple = DefaultArgsTuple()) {
         static_assert(default_arg_position < 0, "Cannot have a default value for a v8::Local<T> parameter");
         PB_PRINT("ParameterBuilder handling v8::Local<{}>", xl::demangle<T>());
@@ -409,7 +416,7 @@ struct ParameterBuilder<
 //
 //    template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
 //    v8toolkit::Holder operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-//                            std::vector<std::unique_ptr<StuffBase>> & stuff,
+//                            ParameterStorage & stuff,
 //                            DefaultArgsTuple const & default_args_tuple = DefaultArgsTuple()) {
 //        PB_PRINT("ParameterBuilder handling v8::Local<{}>", xl::demangle<T>());
 //
@@ -430,7 +437,7 @@ struct ParameterBuilder<
 
     template<int default_arg_position, class DefaultArgsTuple = std::tuple<>>
     v8toolkit::This operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-                                     std::vector<std::unique_ptr<StuffBase>> & stuff,
+                                     ParameterStorage & stuff,
                                      DefaultArgsTuple const & default_args_tuple = DefaultArgsTuple()) {
         PB_PRINT("ParameterBuilder handling v8::Local<{}>", xl::demangle<T>());
 
@@ -441,4 +448,47 @@ struct ParameterBuilder<
 };
 
 
+
+/**
+ * Whether ParameterBuilder fills a parameter of type T from a JavaScript argument, as opposed to from the call
+ * itself (the isolate, context, `this` or the v8::FunctionCallbackInfo)
+ */
+template<class T>
+constexpr bool parameter_uses_js_argument_v =
+    !std::is_same_v<T, v8::Isolate *> &&
+    !std::is_same_v<T, v8::Local<v8::Context>> &&
+    !std::is_same_v<T, v8toolkit::This> &&
+    !std::is_same_v<T, const v8::FunctionCallbackInfo<v8::Value> &>;
+
+
+/**
+ * Cheap check of whether a JavaScript value is the kind of value a parameter of type T is normally built from, used
+ * to choose between overloads without attempting the conversion.  A match doesn't guarantee CastToNative will
+ * succeed and a mismatch doesn't guarantee it will fail (a string can be converted to a number).
+ */
+template<class T>
+bool js_value_matches_parameter(v8::Local<v8::Value> value) {
+    using NoRefT = std::remove_cv_t<std::remove_reference_t<T>>;
+    using ValueT = std::conditional_t<is_string_not_owning_memory_v<NoRefT>,
+        NoRefT, std::remove_cv_t<std::remove_pointer_t<NoRefT>>>;
+
+    if constexpr(is_string_not_owning_memory_v<ValueT> || xl::is_template_for_v<std::basic_string, ValueT>) {
+        return value->IsString();
+    } else if constexpr(std::is_same_v<ValueT, bool>) {
+        return value->IsBoolean();
+    } else if constexpr(std::is_arithmetic_v<ValueT> || std::is_enum_v<ValueT>) {
+        return value->IsNumber();
+    } else if constexpr(is_wrapped_type_v<ValueT>) {
+        return value->IsObject() || (std::is_pointer_v<NoRefT> && value->IsNull());
+    } else if constexpr(acts_like_array_v<ValueT>) {
+        return value->IsArray() || value->IsTypedArray();
+    } else if constexpr(acts_like_map_v<ValueT>) {
+        return value->IsObject();
+    } else if constexpr(xl::is_template_for_v<std::function, ValueT> || xl::is_template_for_v<func::function, ValueT>) {
+        return value->IsFunction();
+    } else {
+        return true;
+    }
+}
+
 } // namespace v8toolkit
\ No newline at end of file
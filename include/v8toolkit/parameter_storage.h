@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "type_traits.h"
+
+namespace v8toolkit {
+
+
+/**
+ * Holds the temporaries created while building the parameters for a single call from JavaScript into C++ - the
+ * objects that pointer and reference parameters point to and the memory behind char * and string_view parameters.
+ * Everything stored is destroyed, in reverse order, when the storage goes away after the call returns.
+ *
+ * Objects are constructed in a buffer provided by InlineParameterStorage, which lives on the stack of the call.
+ * Objects which don't fit in the buffer are heap allocated.
+ */
+class ParameterStorage {
+
+    struct Entry {
+        void (*destroy)(Entry *) = nullptr;
+        Entry * previous = nullptr;
+    };
+
+    template<class T>
+    struct TypedEntry : Entry {
+        T value;
+
+        template<class... Args>
+        TypedEntry(Args &&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+    std::byte * buffer;
+    size_t capacity;
+    size_t used = 0;
+    Entry * last = nullptr;
+
+protected:
+    ParameterStorage(std::byte * buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    /**
+     * Destroys everything stored, most recent first
+     */
+    void clear() {
+        while (this->last != nullptr) {
+            auto previous = this->last->previous;
+            this->last->destroy(this->last);
+            this->last = previous;
+        }
+        this->used = 0;
+    }
+
+public:
+    ParameterStorage(ParameterStorage const &) = delete;
+    ParameterStorage & operator=(ParameterStorage const &) = delete;
+
+    ~ParameterStorage() {
+        this->clear();
+    }
+
+
+    /**
+     * The worst-case number of buffer bytes used by storing a T, including alignment padding
+     */
+    template<class T>
+    static constexpr size_t bytes_for() {
+        return sizeof(TypedEntry<T>) + alignof(TypedEntry<T>) - 1;
+    }
+
+
+    /**
+     * Constructs a T from the given arguments and returns a reference to it which stays valid until the storage
+     * is destroyed
+     */
+    template<class T, class... Args>
+    T & emplace(Args &&... args) {
+        using EntryT = TypedEntry<T>;
+
+        EntryT * entry;
+        void * location = this->buffer + this->used;
+        size_t space = this->capacity - this->used;
+        if (std::align(alignof(EntryT), sizeof(EntryT), location, space) != nullptr) {
+            entry = new(location) EntryT(std::forward<Args>(args)...);
+            entry->destroy = [](Entry * entry) {
+                static_cast<EntryT *>(entry)->~EntryT();
+            };
+            this->used = this->capacity - space + sizeof(EntryT);
+        } else {
+            entry = new EntryT(std::forward<Args>(args)...);
+            entry->destroy = [](Entry * entry) {
+                delete static_cast<EntryT *>(entry);
+            };
+        }
+        entry->previous = this->last;
+        this->last = entry;
+        return entry->value;
+    }
+};
+
+
+/**
+ * ParameterStorage with an inline buffer of Bytes bytes
+ */
+template<size_t Bytes>
+class InlineParameterStorage : public ParameterStorage {
+    alignas(std::max_align_t) std::byte storage[Bytes > 0 ? Bytes : 1];
+
+public:
+    InlineParameterStorage() : ParameterStorage(this->storage, Bytes) {}
+
+    ~InlineParameterStorage() {
+        // objects in the buffer must be destroyed before the buffer is
+        this->clear();
+    }
+};
+
+
+/**
+ * Temporaries larger than this are always heap allocated instead of making every call's stack frame bigger
+ */
+constexpr size_t MaximumInlineParameterBytes = 256;
+
+
+/**
+ * The inline storage needed by ParameterBuilder for a parameter of type T
+ */
+template<class T>
+constexpr size_t parameter_storage_bytes() {
+    if constexpr(std::is_reference_v<T> || std::is_pointer_v<T>) {
+        using ValueT = std::remove_cv_t<std::remove_pointer_t<std::remove_reference_t<T>>>;
+        if constexpr(is_string_not_owning_memory_v<std::remove_cv_t<std::remove_reference_t<T>>>) {
+            return ParameterStorage::bytes_for<std::unique_ptr<char[]>>();
+        } else if constexpr(std::is_object_v<ValueT> && !std::is_abstract_v<ValueT> &&
+                            ParameterStorage::bytes_for<ValueT>() <= MaximumInlineParameterBytes) {
+            return ParameterStorage::bytes_for<ValueT>();
+        } else {
+            return 0;
+        }
+    } else if constexpr(is_string_not_owning_memory_v<std::remove_cv_t<T>>) {
+        return ParameterStorage::bytes_for<std::unique_ptr<char[]>>();
+    } else {
+        return 0;
+    }
+}
+
+
+/**
+ * Storage for the temporaries of a call to a function taking Args..., sized at compile time so a typical call
+ * doesn't allocate
+ */
+template<class... Args>
+using ParameterStorageFor = InlineParameterStorage<(size_t(0) + ... + parameter_storage_bytes<Args>())>;
+
+
+} // end namespace v8toolkit
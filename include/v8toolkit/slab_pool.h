@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace v8toolkit {
+
+/**
+ * Fixed-size object pool which hands out storage for objects of type T from large slabs instead of making a heap
+ *   allocation per object.  Freed blocks are kept on an intrusive free list and reused before a new slab is allocated.
+ * Not thread safe - intended to be owned by an object that is only used from a single isolate at a time.
+ * Destroying the pool releases all slabs without running destructors on any objects still alive in it.
+ */
+template<class T, size_t BlockCountPerSlab = 256>
+class SlabPool {
+    static_assert(BlockCountPerSlab > 0, "SlabPool must have at least one block per slab");
+
+    // a block is either holding a live T or is a link in the free list
+    union Block {
+        Block * next_free;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<Block *> slabs;
+    Block * free_list = nullptr;
+    size_t live_count = 0;
+
+    void allocate_slab() {
+        auto slab = new Block[BlockCountPerSlab];
+        this->slabs.push_back(slab);
+
+        // push blocks in reverse so they are handed out in address order
+        for (size_t i = BlockCountPerSlab; i > 0; i--) {
+            slab[i - 1].next_free = this->free_list;
+            this->free_list = &slab[i - 1];
+        }
+    }
+
+public:
+    SlabPool() = default;
+    SlabPool(SlabPool const &) = delete;
+    SlabPool & operator=(SlabPool const &) = delete;
+
+    ~SlabPool() {
+        this->release_all();
+    }
+
+
+    /**
+     * Constructs a new T in a pooled block
+     * @param args parameters forwarded to T's constructor
+     * @return pointer to the newly constructed object, which must be returned with `destroy`
+     */
+    template<class... Args>
+    T * create(Args&&... args) {
+        if (this->free_list == nullptr) {
+            this->allocate_slab();
+        }
+        Block * block = this->free_list;
+        this->free_list = block->next_free;
+
+        T * result;
+        try {
+            result = new(block->storage) T(std::forward<Args>(args)...);
+        } catch(...) {
+            block->next_free = this->free_list;
+            this->free_list = block;
+            throw;
+        }
+        this->live_count++;
+        return result;
+    }
+
+
+    /**
+     * Runs the destructor on an object previously returned from `create` and returns its block to the pool
+     * @param object object to destroy
+     */
+    void destroy(T * object) {
+        object->~T();
+        auto block = reinterpret_cast<Block *>(object);
+        block->next_free = this->free_list;
+        this->free_list = block;
+        this->live_count--;
+    }
+
+
+    /**
+     * Frees all slabs.  Any objects still alive are not destructed and any pointers to them are no longer valid
+     */
+    void release_all() {
+        for (auto slab : this->slabs) {
+            delete [] slab;
+        }
+        this->slabs.clear();
+        this->free_list = nullptr;
+        this->live_count = 0;
+    }
+
+
+    /**
+     * @return number of objects currently alive in the pool
+     */
+    size_t size() const {
+        return this->live_count;
+    }
+
+
+    /**
+     * @return number of objects which can be alive in the pool before another slab must be allocated
+     */
+    size_t capacity() const {
+        return this->slabs.size() * BlockCountPerSlab;
+    }
+};
+
+
+} // end namespace v8toolkit
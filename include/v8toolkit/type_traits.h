@@ -256,6 +256,34 @@ using acts_like_map = _acts_like_map<std::decay_t<T>>;
 template<typename T>
 constexpr bool acts_like_map_v = acts_like_map<T>::value;
 
+
+/**
+ * Whether an associative container allows only one element per key (std::map, std::set) as opposed to
+ * multiple (std::multimap)
+ */
+template<typename T, typename = void>
+struct has_unique_keys : public std::false_type {};
+
+template<typename T>
+struct has_unique_keys<T, std::void_t<decltype(std::declval<T &>().insert(std::declval<typename T::value_type>()).second)>> :
+    public std::true_type {};
+
+template<typename T>
+constexpr bool has_unique_keys_v = has_unique_keys<std::decay_t<T>>::value;
+
+
+/**
+ * Whether T has a class-specific operator new, declared or inherited, which `delete` on a T pairs with
+ */
+template<typename T, typename = void>
+struct has_class_operator_new : public std::false_type {};
+
+template<typename T>
+struct has_class_operator_new<T, std::void_t<decltype(T::operator new(std::size_t{}))>> : public std::true_type {};
+
+template<typename T>
+constexpr bool has_class_operator_new_v = has_class_operator_new<T>::value;
+
 template<typename T, typename = void>
 struct constructed_from_callback_info : public std::false_type {};
 
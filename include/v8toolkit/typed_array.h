@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <v8.h>
+
+namespace v8toolkit {
+
+
+/**
+ * Maps an arithmetic C++ type to the JavaScript TypedArray with the same element representation.  `supported` is
+ * false for types with no matching TypedArray (bool and 64-bit integers).
+ */
+template<class T, class = void>
+struct TypedArrayTraits {
+    static constexpr bool supported = false;
+};
+
+template<class T>
+struct TypedArrayTraits<T, std::enable_if_t<
+    std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool> &&
+    (std::is_floating_point_v<T> ? (sizeof(T) == 4 || sizeof(T) == 8) : sizeof(T) <= 4)>> {
+
+    static constexpr bool supported = true;
+
+    static v8::Local<v8::TypedArray> create(v8::Local<v8::ArrayBuffer> buffer, size_t length) {
+        if constexpr(std::is_floating_point_v<T>) {
+            if constexpr(sizeof(T) == 4) {
+                return v8::Float32Array::New(buffer, 0, length);
+            } else {
+                return v8::Float64Array::New(buffer, 0, length);
+            }
+        } else if constexpr(std::is_signed_v<T>) {
+            if constexpr(sizeof(T) == 1) {
+                return v8::Int8Array::New(buffer, 0, length);
+            } else if constexpr(sizeof(T) == 2) {
+                return v8::Int16Array::New(buffer, 0, length);
+            } else {
+                return v8::Int32Array::New(buffer, 0, length);
+            }
+        } else {
+            if constexpr(sizeof(T) == 1) {
+                return v8::Uint8Array::New(buffer, 0, length);
+            } else if constexpr(sizeof(T) == 2) {
+                return v8::Uint16Array::New(buffer, 0, length);
+            } else {
+                return v8::Uint32Array::New(buffer, 0, length);
+            }
+        }
+    }
+
+    /**
+     * Whether the TypedArray's elements have exactly the representation of T so they can be copied bytewise
+     */
+    static bool matches(v8::Local<v8::TypedArray> typed_array) {
+        if constexpr(std::is_floating_point_v<T>) {
+            return sizeof(T) == 4 ? typed_array->IsFloat32Array() : typed_array->IsFloat64Array();
+        } else if constexpr(std::is_signed_v<T>) {
+            return sizeof(T) == 1 ? typed_array->IsInt8Array() :
+                   sizeof(T) == 2 ? typed_array->IsInt16Array() : typed_array->IsInt32Array();
+        } else {
+            return sizeof(T) == 1 ? typed_array->IsUint8Array() || typed_array->IsUint8ClampedArray() :
+                   sizeof(T) == 2 ? typed_array->IsUint16Array() : typed_array->IsUint32Array();
+        }
+    }
+};
+
+
+/**
+ * Whether a container's elements can be read and written in place through data()
+ */
+template<class Container, class = void>
+struct has_contiguous_storage : std::false_type {};
+
+template<class Container>
+struct has_contiguous_storage<Container, std::enable_if_t<
+    std::is_same_v<decltype(std::declval<Container &>().data()), typename Container::value_type *>>> : std::true_type {};
+
+template<class Container>
+constexpr bool has_contiguous_storage_v = has_contiguous_storage<Container>::value;
+
+
+/**
+ * Specialize as std::true_type for an arithmetic element type to have CastToJS return std::vector<T> as a TypedArray
+ * instead of an Array.  An rvalue vector's storage becomes the TypedArray's backing store without being copied; an
+ * lvalue vector is copied with a single memcpy.  The TypedArray can't grow, so only opt in for types where JavaScript
+ * doesn't need Array methods like push.
+ */
+template<class T>
+struct cast_to_js_as_typed_array : std::false_type {};
+
+template<class T>
+constexpr bool cast_to_js_as_typed_array_v = TypedArrayTraits<T>::supported && cast_to_js_as_typed_array<std::remove_cv_t<T>>::value;
+
+
+/**
+ * Owns a vector whose storage is used as an ArrayBuffer's backing store.  Deleted when the ArrayBuffer is
+ * garbage collected.
+ */
+template<class Vector>
+struct TypedArrayBackingStore {
+    Vector vector;
+    v8::Global<v8::ArrayBuffer> global;
+
+    TypedArrayBackingStore(Vector && vector) : vector(std::move(vector)) {}
+
+    int64_t byte_length() const {
+        return static_cast<int64_t>(this->vector.size() * sizeof(typename Vector::value_type));
+    }
+
+    static void weak_callback(v8::WeakCallbackInfo<TypedArrayBackingStore> const & info) {
+        auto backing_store = info.GetParameter();
+        info.GetIsolate()->AdjustAmountOfExternalAllocatedMemory(-backing_store->byte_length());
+        backing_store->global.Reset();
+        delete backing_store;
+    }
+};
+
+
+/**
+ * Creates a TypedArray using the vector's storage as its backing store
+ */
+template<class Vector>
+v8::Local<v8::TypedArray> move_vector_to_typed_array(v8::Isolate * isolate, Vector && vector) {
+    using ValueT = typename Vector::value_type;
+    auto length = vector.size();
+    if (length == 0) {
+        return TypedArrayTraits<ValueT>::create(v8::ArrayBuffer::New(isolate, 0), 0);
+    }
+
+    auto backing_store = new TypedArrayBackingStore<Vector>(std::move(vector));
+    auto buffer = v8::ArrayBuffer::New(isolate, backing_store->vector.data(), backing_store->byte_length(),
+                                       v8::ArrayBufferCreationMode::kExternalized);
+    isolate->AdjustAmountOfExternalAllocatedMemory(backing_store->byte_length());
+    backing_store->global.Reset(isolate, buffer);
+    backing_store->global.SetWeak(backing_store, &TypedArrayBackingStore<Vector>::weak_callback, v8::WeakCallbackType::kParameter);
+
+    return TypedArrayTraits<ValueT>::create(buffer, length);
+}
+
+
+/**
+ * Creates a TypedArray holding a copy of the given elements
+ */
+template<class T>
+v8::Local<v8::TypedArray> copy_to_typed_array(v8::Isolate * isolate, T const * data, size_t length) {
+    auto buffer = v8::ArrayBuffer::New(isolate, length * sizeof(T));
+    if (length > 0) {
+        std::memcpy(buffer->GetContents().Data(), data, length * sizeof(T));
+    }
+    return TypedArrayTraits<T>::create(buffer, length);
+}
+
+
+/**
+ * Calls callable with a pointer to the TypedArray's elements as their actual C++ type and the number of elements.
+ * Returns false without calling it for element types with no C++ equivalent here (BigInt arrays).
+ */
+template<class Callable>
+bool visit_typed_array(v8::Local<v8::TypedArray> typed_array, Callable && callable) {
+    auto length = typed_array->Length();
+    auto bytes = static_cast<char const *>(typed_array->Buffer()->GetContents().Data()) + typed_array->ByteOffset();
+
+    if (typed_array->IsFloat64Array()) {
+        callable(reinterpret_cast<double const *>(bytes), length);
+    } else if (typed_array->IsFloat32Array()) {
+        callable(reinterpret_cast<float const *>(bytes), length);
+    } else if (typed_array->IsInt32Array()) {
+        callable(reinterpret_cast<int32_t const *>(bytes), length);
+    } else if (typed_array->IsUint32Array()) {
+        callable(reinterpret_cast<uint32_t const *>(bytes), length);
+    } else if (typed_array->IsInt16Array()) {
+        callable(reinterpret_cast<int16_t const *>(bytes), length);
+    } else if (typed_array->IsUint16Array()) {
+        callable(reinterpret_cast<uint16_t const *>(bytes), length);
+    } else if (typed_array->IsInt8Array()) {
+        callable(reinterpret_cast<int8_t const *>(bytes), length);
+    } else if (typed_array->IsUint8Array() || typed_array->IsUint8ClampedArray()) {
+        callable(reinterpret_cast<uint8_t const *>(bytes), length);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ * Non-owning view of contiguous elements, used to pass ArrayBuffer and TypedArray contents to native functions
+ * without copying them.  A function parameter of type Span<T> or Span<T const> points directly at the JavaScript
+ * object's memory, which is only guaranteed to stay valid until the function returns.
+ */
+template<class T>
+class Span {
+    T * pointer = nullptr;
+    size_t length = 0;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T *;
+
+    Span() = default;
+    Span(T * pointer, size_t length) : pointer(pointer), length(length) {}
+
+    template<class U, class = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    Span(Span<U> const & other) : pointer(other.data()), length(other.size()) {}
+
+    T * data() const {return this->pointer;}
+    size_t size() const {return this->length;}
+    size_t size_bytes() const {return this->length * sizeof(T);}
+    bool empty() const {return this->length == 0;}
+    T & operator[](size_t index) const {return this->pointer[index];}
+    T * begin() const {return this->pointer;}
+    T * end() const {return this->pointer + this->length;}
+};
+
+
+/**
+ * Returns the memory backing an ArrayBuffer or any ArrayBufferView (TypedArray or DataView), or an empty optional for
+ * any other value
+ */
+inline std::optional<Span<std::byte>> get_array_buffer_bytes(v8::Local<v8::Value> value) {
+    if (value->IsArrayBufferView()) {
+        auto view = v8::Local<v8::ArrayBufferView>::Cast(value);
+        auto bytes = static_cast<std::byte *>(view->Buffer()->GetContents().Data());
+        return Span<std::byte>(bytes + view->ByteOffset(), view->ByteLength());
+    } else if (value->IsArrayBuffer()) {
+        auto contents = v8::Local<v8::ArrayBuffer>::Cast(value)->GetContents();
+        return Span<std::byte>(static_cast<std::byte *>(contents.Data()), contents.ByteLength());
+    }
+    return {};
+}
+
+
+/**
+ * Returns the characters of a JavaScript string without copying them, if that's possible.  Only strings whose
+ * characters are stored outside the V8 heap as one-byte data (external strings) can be viewed directly, and only if
+ * they're pure ASCII so the view is also valid UTF-8.  The view is only valid as long as the string is alive.
+ */
+inline std::optional<std::string_view> get_external_string_view(v8::Local<v8::Value> value) {
+    if (!value->IsString()) {
+        return {};
+    }
+    v8::String::Encoding encoding;
+    auto resource = v8::Local<v8::String>::Cast(value)->GetExternalStringResourceBase(&encoding);
+    if (resource == nullptr || encoding != v8::String::ONE_BYTE_ENCODING) {
+        return {};
+    }
+    auto one_byte_resource = static_cast<v8::String::ExternalOneByteStringResource const *>(resource);
+    std::string_view string(one_byte_resource->data(), one_byte_resource->length());
+    for (auto c : string) {
+        if (static_cast<unsigned char>(c) > 0x7f) {
+            return {};
+        }
+    }
+    return string;
+}
+
+
+} // end namespace v8toolkit
@@ -10,6 +10,7 @@
 
 #include "v8helpers.h"
 #include "casts.h"
+#include "parameter_storage.h"
 
 namespace v8toolkit {
 
@@ -35,16 +36,25 @@ struct cast_to_native_no_value<T, std::enable_if_t<std::result_of_t<CastToNative
 };
 
 
+/**
+ * Returns a pointer to the value to use for a parameter not specified from JavaScript.  Default arguments are shared
+ * by every call, so a const T points directly at the default argument while a non-const T gets a copy of it
+ * the function is free to modify.
+ */
 template<class T, int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
-T * get_default_parameter(const v8::FunctionCallbackInfo<v8::Value> & info, int & i, std::vector<std::unique_ptr<StuffBase>> & stuff,
+T * get_default_parameter(const v8::FunctionCallbackInfo<v8::Value> & info, int & i, ParameterStorage & stuff,
                           DefaultArgsTuple && default_args_tuple) {
+    using NoConstT = std::remove_const_t<T>;
 
     // prioritize the default_args_tuple value if available
     if constexpr(default_arg_position >= 0) {
-        return const_cast<T*>(&std::get<default_arg_position>(default_args_tuple));
-    } else if constexpr(cast_to_native_supports_default_value_v<T>) {
-        stuff.push_back(Stuff<T>::stuffer(CastToNative<T>()(info.GetIsolate())));
-        return static_cast<Stuff<T>&>(stuff.back()).get();
+        if constexpr(std::is_const_v<T>) {
+            return &std::get<default_arg_position>(default_args_tuple);
+        } else {
+            return &stuff.emplace<NoConstT>(std::get<default_arg_position>(default_args_tuple));
+        }
+    } else if constexpr(cast_to_native_supports_default_value_v<NoConstT>) {
+        return &stuff.emplace<NoConstT>(CastToNative<NoConstT>()(info.GetIsolate()));
     } else {
         throw CastException("No default value available for type {}", xl::demangle<T>());
     }
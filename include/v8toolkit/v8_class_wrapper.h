@@ -11,6 +11,8 @@
 #include <utility>
 #include <assert.h>
 #include <functional>
+#include <deque>
+#include <unordered_set>
 
 #include <xl/demangle.h>
 #include <xl/member_function_type_traits.h>
@@ -20,12 +22,17 @@
 
 #ifdef USE_EASTL_FOR_INTERNALS
 #include <EASTL/vector_map.h>
+#include <EASTL/bonus/ring_buffer.h>
 template<class... ArgTs>
 using MapT=eastl::vector_map<ArgTs...>;
+template<class T>
+using QueueT=eastl::ring_buffer<T>;
 #else
 #include <map>
 template<class... ArgTs>
 using MapT=std::map<ArgTs...>;
+template<class T>
+using QueueT=std::deque<T>;
 #endif
 
 #include "wrapped_class_base.h"
@@ -33,6 +40,8 @@ using MapT=std::map<ArgTs...>;
 #include "casts.h"
 #include "any.h"
 #include "type_traits.h"
+#include "slab_pool.h"
+#include "object_arena.h"
 
 // allow _v8 suffix for making v8::String objects
 using namespace v8toolkit::literals;
@@ -58,6 +67,34 @@ namespace v8toolkit {
 #endif
 
 
+/**
+ * Customization point for how much native memory a wrapped object keeps alive, which is reported to V8 so
+ *   garbage collection pressure reflects objects owning large buffers.  Specialize for types whose size
+ *   is dominated by memory they own:
+ * \code
+ * template<> struct ExternalSize<Image> {
+ *     size_t operator()(Image const & image) const {return sizeof(Image) + image.pixels.capacity();}
+ * };
+ * \endcode
+ * If the size changes after the object is wrapped, call V8ClassWrapper<T>::update_external_size
+ */
+template<class T, class = void>
+struct ExternalSize {
+	size_t operator()(T const &) const {
+		return sizeof(T);
+	}
+};
+
+
+/**
+ * Returns the amount of native memory reported to V8 for the given object - see ExternalSize
+ */
+template<class T>
+size_t external_size(T const & object) {
+	return ExternalSize<std::remove_cv_t<T>>()(object);
+}
+
+
 /***
 * set of classes for determining what to do do the underlying c++ object when the javascript object is garbage collected
 */
@@ -87,14 +124,12 @@ struct DestructorBehavior_Delete : DestructorBehavior {
 		T* object = (T*)void_object;
         V8TOOLKIT_DEBUG("Deleting underlying C++ object at %p during V8 garbage collection\n", void_object);
 		delete object;
-		isolate->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(sizeof(T)));
 	}
 
 	void operator()(v8::Isolate * isolate, const volatile void * void_object) const override {
 		T* object = (T*)void_object;
 		V8TOOLKIT_DEBUG("Deleting underlying C++ object at %p during V8 garbage collection\n", void_object);
 		delete object;
-		isolate->AdjustAmountOfExternalAllocatedMemory(-static_cast<int64_t>(sizeof(T)));
 	}
 
 	bool destructive() const override {
@@ -265,6 +300,22 @@ struct TypeChecker<T, v8toolkit::TypeList<Head, Tail...>,
 
 
 
+/**
+ * Live JavaScript objects wrapping C++ objects for a single V8ClassWrapper, split by whether the JavaScript object
+ * is responsible for destroying the C++ object, along with the external memory reported to V8 for each group.
+ */
+struct WrappedObjectCensus {
+	std::string class_name;
+	size_t owning_objects = 0;
+	size_t non_owning_objects = 0;
+	int64_t owning_external_bytes = 0;
+	int64_t non_owning_external_bytes = 0;
+
+	// entries in the wrapper's C++ object -> JavaScript object lookup map
+	size_t existing_wrapped_objects = 0;
+};
+
+
 /**
  * Stores a list of callbacks to clean up V8ClassWrapper objects when the associated isolate is destroyed.
  * An isolate created after a previous isolate is destroyed may have the same address but a new wrapper must be
@@ -273,17 +324,36 @@ struct TypeChecker<T, v8toolkit::TypeList<Head, Tail...>,
 class V8ClassWrapperInstanceRegistry {
 private:
 	MapT<v8::Isolate *, std::vector<func::function<void()>>> isolate_to_callback_map;
+	MapT<v8::Isolate *, std::vector<func::function<WrappedObjectCensus()>>> isolate_to_census_map;
 
 public:
 	void add_callback(v8::Isolate * isolate, func::function<void()> callback) {
 		this->isolate_to_callback_map[isolate].push_back(callback);
 	};
+	void add_census_callback(v8::Isolate * isolate, func::function<WrappedObjectCensus()> callback) {
+		this->isolate_to_census_map[isolate].push_back(callback);
+	};
 	void cleanup_isolate(v8::Isolate * isolate) {
 //        std::cerr << fmt::format("cleaning up isolate: {}", (void*)isolate) << std::endl;
 		for (auto & callback : this->isolate_to_callback_map[isolate]) {
 			callback();
 		}
 		this->isolate_to_callback_map.erase(isolate);
+		this->isolate_to_census_map.erase(isolate);
+	}
+
+	/**
+	 * Returns the live object census of every V8ClassWrapper created for the isolate
+	 */
+	std::vector<WrappedObjectCensus> get_census(v8::Isolate * isolate) {
+		std::vector<WrappedObjectCensus> result;
+		auto census_callbacks = this->isolate_to_census_map.find(isolate);
+		if (census_callbacks != this->isolate_to_census_map.end()) {
+			for (auto & callback : census_callbacks->second) {
+				result.push_back(callback());
+			}
+		}
+		return result;
 	}
 };
 
@@ -307,29 +377,85 @@ inline MapT<v8::Isolate *, std::vector<std::string>> used_constructor_name_list_
 
 
 
+template<class Container>
+struct ContainerView;
+
+
 /**
- * Holds the c++ object to be embedded inside a javascript object along with additional debugging information
- *   when requested
+ * Type-independent portion of the per-object data embedded inside a javascript object wrapping a c++ object.
+ * The internal field of every wrapped javascript object points at one of these, regardless of the wrapped type.
  */
-template<class T>
-struct WrappedData {
+struct WrappedObjectHeader {
 
-	// holds the wrapped C++ object such that the actual type can be determined at runtime
+	// holds the wrapped C++ object such that the actual type can be determined at runtime.  Points into the
+	//   same allocation as this header
 	AnyBase * native_object;
 
-	// the callback associated with the JS GC such that it can be changed if necessary
-	SetWeakCallbackData * weak_callback_data = nullptr;
+	// weak handle to the javascript object which triggers cleanup when it is garbage collected.  Also used to find
+	//   the existing javascript object when the same c++ object is wrapped again
+	v8::Global<v8::Object> global;
 
-	WrappedData(T * native_object,
-				SetWeakCallbackData * weak_callback_data) :
-		native_object(new AnyPtr<T>(native_object)),
-		weak_callback_data(weak_callback_data)
-	{
-//		std::cerr << fmt::format("created WrappedData<{}> with native_object = {} - this: {}\n", xl::demangle<T>(), (void*)native_object, (void*)this);
+	// what to do with the c++ object when the javascript object is garbage collected.  nullptr once the memory
+	//   has been released from the javascript object
+	DestructorBehavior const * destructor_behavior;
+
+	// amount currently reported to V8 via AdjustAmountOfExternalAllocatedMemory for this object
+	int64_t external_size = 0;
+
+	// census of the V8ClassWrapper which created this object
+	WrappedObjectCensus * census = nullptr;
+
+	// computes ExternalSize for native_object as the type of the V8ClassWrapper which created this object, which
+	//   may be more derived than the wrapper the object is later seen through
+	int64_t (*compute_external_size)(AnyBase * native_object) = nullptr;
+
+	// intrusive list of all objects still alive for the V8ClassWrapper which created them
+	WrappedObjectHeader * previous_live = nullptr;
+	WrappedObjectHeader * next_live = nullptr;
+
+	WrappedObjectHeader(AnyBase * native_object, DestructorBehavior const & destructor_behavior) :
+		native_object(native_object),
+		destructor_behavior(&destructor_behavior)
+	{}
+
+	/**
+	 * Whether the javascript object is responsible for cleaning up the c++ object
+	 */
+	bool owns_memory() const {
+		return this->destructor_behavior != nullptr && this->destructor_behavior->destructive();
 	}
 
-	~WrappedData(){delete native_object;}
+	/**
+	 * Adds (count = 1) or removes (count = -1) this object's current ownership and external size to or from
+	 * its census.  Must be removed before changing either and added back afterwards.
+	 */
+	void update_census(int count) {
+		if (this->owns_memory()) {
+			this->census->owning_objects += count;
+			this->census->owning_external_bytes += count * this->external_size;
+		} else {
+			this->census->non_owning_objects += count;
+			this->census->non_owning_external_bytes += count * this->external_size;
+		}
+	}
+};
+
+
+/**
+ * Holds the c++ object to be embedded inside a javascript object along with the bookkeeping needed to
+ *   clean it up.  Everything lives in a single block allocated out of a per-isolate, per-type SlabPool
+ */
+template<class T>
+struct WrappedData : public WrappedObjectHeader {
+
+	AnyPtr<T> any_ptr;
 
+	WrappedData(T * native_object, DestructorBehavior const & destructor_behavior) :
+		WrappedObjectHeader(&this->any_ptr, destructor_behavior),
+		any_ptr(native_object)
+	{
+//		std::cerr << fmt::format("created WrappedData<{}> with native_object = {} - this: {}\n", xl::demangle<T>(), (void*)native_object, (void*)this);
+	}
 };
 
 
@@ -374,6 +500,24 @@ private:
 													   const std::string &,
 													   const v8::Local<v8::Value> & value)>;
 
+public:
+
+	/// Interned identifier for a data member, assigned in the order members are added
+	using MemberId = uint32_t;
+
+	// Callback type for notifying when a data member has been changed, identified by its MemberId
+	using MemberChangedCallback = func::function<void(v8::Isolate * isolate, T * cpp_object, MemberId member_id)>;
+
+	/**
+	 * A pending change to a data member, queued when property change batching is enabled
+	 */
+	struct MemberChange {
+		T * cpp_object;
+		MemberId member_id;
+	};
+
+private:
+
     // Callback type to add a FakeMethod to an ObjectTemplate
 	using FakeMethodAdder = func::function<void(v8::Local<v8::ObjectTemplate>)>;
 
@@ -395,6 +539,22 @@ private:
 	/// List of callbacks for when attributes change
 	std::vector<PropertyChangedCallback> property_changed_callbacks;
 
+	/// List of callbacks for when data members change, by MemberId
+	std::vector<MemberChangedCallback> member_changed_callbacks;
+
+	/// Names of data members, indexed by MemberId
+	std::vector<std::string> member_names;
+
+	/// Call metrics for data member accessors, indexed by MemberId
+	std::vector<CallMetrics *> member_metrics;
+
+	/// Call metrics shared by all constructors added for this type
+	CallMetrics * constructor_metrics = nullptr;
+
+	/// If set, member changes are queued here instead of calling member_changed_callbacks
+	bool batch_member_changes = false;
+	QueueT<MemberChange> pending_member_changes;
+
 
 	// stores callbacks to add calls to lambdas whos first parameter is of type T* and are automatically passed
 	//   the "this" pointer before any javascript parameters are passed in
@@ -406,24 +566,36 @@ private:
 	std::string class_name = xl::demangle<T>();
 
 	/**
-	 * List of names already in use for methods/static methods/accessors
+	 * Names already in use for methods/static methods/accessors
 	 * Used to make sure duplicate names aren't requested
 	 */
-    std::vector<std::string> used_attribute_name_list;
+    std::unordered_set<std::string> used_attribute_names;
 
     /**
-     * List of names already used for properties on the constructor function
+     * Names already used for properties on the constructor function
      */
-    std::vector<std::string> used_static_attribute_name_list;
+    std::unordered_set<std::string> used_static_attribute_names;
 
 
     /**
-     * Mapping between CPP object pointer and JavaScript object for CPP objects which have already been
-     * wrapped so the previous wrapped object can be returned.
-     * Note: this stops any objects from ever being deleted and can cause problems if another object of the same
-     * type is created at the same memory address.
+     * Mapping between CPP object pointer and the data embedded in the JavaScript object for CPP objects which
+     * have already been wrapped so the previous wrapped object can be returned.  Entries are removed when the
+     * JavaScript object is garbage collected.
      */
-	MapT<T *, v8::Global<v8::Object>> existing_wrapped_objects;
+	MapT<T *, WrappedData<T> *> existing_wrapped_objects;
+
+	// running totals of the live objects created by this wrapper
+	WrappedObjectCensus census{this->class_name};
+
+	/**
+	 * Storage for the WrappedData of every object created by this wrapper
+	 */
+	SlabPool<WrappedData<T>> wrapped_data_pool;
+
+	/**
+	 * Head of the intrusive list of WrappedData still attached to a JavaScript object
+	 */
+	WrappedObjectHeader * live_wrapped_data = nullptr;
 
     /**
      * Isolate associated with this V8ClassWrapper
@@ -465,6 +637,11 @@ private:
     */
     bool finalized = false;
 
+    /**
+     * Registration code for the class which hasn't been run yet - see set_lazy_registration
+     */
+    func::function<void(V8ClassWrapper &)> lazy_registration;
+
     /**
      * Whether the type should try to determine the most derived type of a CPP object or just wrap it as the
      * presented static type - takes longer to determine the most derived type, but may be necessary for having the
@@ -478,6 +655,25 @@ private:
 	// makes a single function to be run when the wrapping javascript object is called with ()
 	MethodAdderData callable_adder;
 
+	/**
+	 * Whether prototype methods are created the first time they're looked up instead of with the prototype
+	 */
+	bool lazy_methods_flag = false;
+
+	/**
+	 * What a lazily installed method needs to create its function when it's first looked up
+	 */
+	struct LazyMethodData {
+		std::string_view method_name;
+		StdFunctionCallbackType * callback;
+
+		// number of prototype objects the method has been created on
+		uint32_t materializations = 0;
+	};
+
+	// Nothing may ever be removed from this deque, as lazy JavaScript properties point into it
+	std::deque<LazyMethodData> lazy_method_data;
+
 	func::function<void(v8::Local<v8::ObjectTemplate>)> named_property_adder;
 	v8::IndexedPropertyGetterCallback indexed_property_getter = nullptr;
 
@@ -515,6 +711,32 @@ private:
 	 */
 	void call_callbacks(v8::Local<v8::Object> object, const std::string & property_name, v8::Local<v8::Value> & value);
 
+	/**
+	 * Assigns the next MemberId to the given data member name
+	 */
+	MemberId intern_member_name(std::string_view member_name) {
+		this->member_names.emplace_back(member_name);
+		this->member_metrics.push_back(this->add_call_metrics(member_name, CallKind::Accessor));
+		return static_cast<MemberId>(this->member_names.size() - 1);
+	}
+
+	/**
+	 * Creates the CallMetrics for a callable belonging to this type in this wrapper's isolate
+	 */
+	CallMetrics * add_call_metrics(std::string_view name, CallKind kind) {
+		return &CallMetricsRegistry::get(this->isolate).add(this->class_name, name, kind);
+	}
+
+	/**
+	 * Called after a data member has been assigned from JavaScript.  Queues or delivers the change by id and
+	 * only builds the property name string if there are name-based callbacks registered
+	 */
+	void notify_member_changed(v8::Local<v8::Object> object,
+							   T * cpp_object,
+							   MemberId member_id,
+							   v8::Local<v8::Name> property,
+							   v8::Local<v8::Value> & value);
+
 
 	/**
 	 * Checks to see if a name has already been used because the V8 error message for a duplicate name is not helpful
@@ -546,18 +768,28 @@ private:
 
 		auto isolate = info.GetIsolate();
 
-		auto cpp_object = V8ClassWrapper<T>::get_instance(isolate).get_cpp_object(info.Holder());
-        log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
-		auto non_const_cpp_object = const_cast<std::remove_const_t<T>*>(cpp_object);
-		using MemberT = decltype(member_getter(non_const_cpp_object));
-
-
-		log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS,
-				 "Reading data member of type {} (need to implement having the name available)",
-				 xl::demangle<MemberT>());
+		auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
+		MemberId member_id = v8::Local<v8::Uint32>::Cast(info.Data())->Value();
+		CallTimer timer(wrapper.member_metrics[member_id]);
 
-		// add lvalue ref as to know not to delete the object if the JS object is garbage collected
-        info.GetReturnValue().Set(CastToJS<std::add_lvalue_reference_t<MemberT>>()(isolate, member_getter(non_const_cpp_object)));
+		try {
+			auto cpp_object = wrapper.get_cpp_object(info.Holder());
+			V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+			auto non_const_cpp_object = const_cast<std::remove_const_t<T>*>(cpp_object);
+			using MemberT = decltype(member_getter(non_const_cpp_object));
+
+
+			V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS,
+					 "Reading data member of type {} (need to implement having the name available)",
+					 xl::demangle<MemberT>());
+
+			// add lvalue ref as to know not to delete the object if the JS object is garbage collected
+			info.GetReturnValue().Set(CastToJS<std::add_lvalue_reference_t<MemberT>>()(isolate, member_getter(non_const_cpp_object)));
+		} catch (std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception reading {} data member: {}", xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+		}
     }
 
 
@@ -578,101 +810,350 @@ private:
 	    auto isolate = info.GetIsolate();
 
         auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
+		MemberId member_id = v8::Local<v8::Uint32>::Cast(info.Data())->Value();
+		CallTimer timer(wrapper.member_metrics[member_id]);
 
+	    T * cpp_object;
+		try {
+			cpp_object = wrapper.get_cpp_object(info.Holder());
+			V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "setter got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
 
-	    T * cpp_object = wrapper.get_cpp_object(info.Holder());
-		log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "setter got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+			using MemberT = std::remove_reference_t<decltype(member_getter(cpp_object))>;
+			using DereferencedMemberT = xl::dereferenced_type_t<MemberT>;
 
-		using MemberT = std::remove_reference_t<decltype(member_getter(cpp_object))>;
-		using DereferencedMemberT = xl::dereferenced_type_t<MemberT>;
+			V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS,
+					 "Setting data member of type {} (need to implement having the name available)",
+					 xl::demangle<MemberT>());
 
-		log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS,
-				 "Setting data member of type {} (need to implement having the name available)",
-				 xl::demangle<MemberT>());
 
-		
-        static_assert(
-        	std::is_pointer_v<MemberT> ||
-            std::is_copy_assignable_v<MemberT> ||
-            std::is_move_assignable_v<MemberT>, "Cannot add_member with a type that is not either copy or move assignable.  Use add_member_readonly instead");
-
-		// if it's copyable, then the assignment is pretty easy
-		if constexpr(is_wrapped_type_v<MemberT>) {
-			if constexpr(std::is_copy_assignable_v<MemberT>)
-			{
-				member_getter(cpp_object) = CastToNative<MemberT &>()(isolate, value);
+			static_assert(
+				std::is_pointer_v<MemberT> ||
+				std::is_copy_assignable_v<MemberT> ||
+				std::is_move_assignable_v<MemberT>, "Cannot add_member with a type that is not either copy or move assignable.  Use add_member_readonly instead");
+
+			// if it's copyable, then the assignment is pretty easy
+			if constexpr(is_wrapped_type_v<MemberT>) {
+				if constexpr(std::is_copy_assignable_v<MemberT>)
+				{
+					member_getter(cpp_object) = CastToNative<MemberT &>()(isolate, value);
+				}
+				// otherwise if it's a wrapped type and it's move assignable, if the object owns its memory, then try a
+				//   move assignment
+				else if constexpr(std::is_move_assignable_v<MemberT>)
+				{
+
+					auto object = get_value_as<v8::Object>(isolate, value);
+					if (wrapper.does_object_own_memory(object)) {
+						member_getter(cpp_object) = CastToNative<MemberT &&>()(isolate, value);
+					}
+				}
 			}
-			// otherwise if it's a wrapped type and it's move assignable, if the object owns its memory, then try a
-			//   move assignment
-			else if constexpr(std::is_move_assignable_v<MemberT>)
-			{
+			// for an unwrapped type, always try to make a copy and do a move assignment from it
+			else {
+				static_assert(is_wrapped_type_v<DereferencedMemberT> || !std::is_pointer_v<MemberT>,
+							  "Cannot assign to a non-wrapped type pointer - Who would own the memory?");
+
+				if constexpr(is_wrapped_type_v<DereferencedMemberT> || !std::is_pointer_v<MemberT>) {
 
-				auto object = get_value_as<v8::Object>(isolate, value);
-				if (wrapper.does_object_own_memory(object)) {
-					member_getter(cpp_object) = CastToNative<MemberT &&>()(isolate, value);
+					auto native_value = CastToNative<MemberT>()(isolate, value);
+					member_getter(cpp_object) = std::move(native_value);
 				}
 			}
+		} catch (std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception setting {} data member: {}", xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+			return;
 		}
-		// for an unwrapped type, always try to make a copy and do a move assignment from it
-		else {
-			static_assert(is_wrapped_type_v<DereferencedMemberT> || !std::is_pointer_v<MemberT>,
-						  "Cannot assign to a non-wrapped type pointer - Who would own the memory?");
 
-			if constexpr(is_wrapped_type_v<DereferencedMemberT> || !std::is_pointer_v<MemberT>) {
 
-				auto native_value = CastToNative<MemberT>()(isolate, value);
-				member_getter(cpp_object) = std::move(native_value);
+	    // call any registered change callbacks
+		wrapper.notify_member_changed(info.Holder(), cpp_object, member_id, property, value);
+	}
+
+
+	/**
+	 * Getter for members added with add_member_view
+	 */
+	template<auto member, bool writable>
+	static void _view_getter_helper(v8::Local<v8::Name> property,
+									v8::PropertyCallbackInfo<v8::Value> const & info) {
+		auto isolate = info.GetIsolate();
+		auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
+		MemberId member_id = v8::Local<v8::Uint32>::Cast(info.Data())->Value();
+		CallTimer timer(wrapper.member_metrics[member_id]);
+
+		try {
+			auto & container = wrapper.get_cpp_object(info.Holder())->*member;
+			using ContainerT = std::remove_reference_t<decltype(container)>;
+			info.GetReturnValue().Set(ContainerView<ContainerT>(container, writable).make_js_object(isolate, info.Holder()));
+		} catch (std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception reading {} data member: {}", xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+		}
+	}
+
+
+	/**
+	 * Accessor data for members added with add_member_fast - the byte offset of the member inside T and the
+	 *   wrapper it was added to, so the accessors don't need to look anything up
+	 */
+	struct FastMemberData {
+		size_t offset;
+		V8ClassWrapper<T> * wrapper;
+		MemberId member_id;
+	};
+
+	// stable addresses for FastMemberData referenced by v8::External accessor data
+	std::deque<FastMemberData> fast_member_data;
+
+
+	/**
+	 * Returns the byte offset of a data member inside a T.  Only meaningful for standard layout types.
+	 */
+	template<auto member>
+	static size_t member_offset() {
+		using UnqualifiedT = std::remove_cv_t<T>;
+		static_assert(std::is_standard_layout_v<UnqualifiedT>, "Fast member access requires a standard layout type");
+		alignas(UnqualifiedT) unsigned char storage[sizeof(UnqualifiedT)];
+		auto object = reinterpret_cast<UnqualifiedT *>(storage);
+		return reinterpret_cast<char *>(&(object->*member)) - reinterpret_cast<char *>(object);
+	}
+
+
+	/**
+	 * Gets the C++ object for fast member access.  If the holder was created by this wrapper (or the wrapper for the
+	 *   non-const version of this type), the pointer is taken directly out of the AnyPtr without consulting the
+	 *   TypeChecker.  Anything else, such as derived types, falls back to get_cpp_object.
+	 */
+	static T * fast_get_cpp_object(v8::Local<v8::Object> holder, FastMemberData const & data) {
+		if (holder->InternalFieldCount() == 1) {
+			auto wrapped_data = static_cast<WrappedObjectHeader *>(v8::Local<v8::External>::Cast(holder->GetInternalField(0))->Value());
+			if (wrapped_data != nullptr) {
+				auto descriptor = &wrapped_data->native_object->type_descriptor;
+				if (descriptor == &get_any_type_descriptor<T>()) {
+					return static_cast<AnyPtr<T> *>(wrapped_data->native_object)->get();
+				}
+				if constexpr(std::is_const_v<T>) {
+					if (descriptor == &get_any_type_descriptor<std::remove_const_t<T>>()) {
+						return static_cast<AnyPtr<std::remove_const_t<T>> *>(wrapped_data->native_object)->get();
+					}
+				}
 			}
 		}
+		return data.wrapper->get_cpp_object(holder);
+	}
 
 
-	    // call any registered change callbacks
-	    V8ClassWrapper<T>::get_instance(isolate).call_callbacks(info.Holder(), *v8::String::Utf8Value(isolate, property), value);
+	template<class MemberT>
+	static MemberT & fast_member_reference(T * cpp_object, FastMemberData const & data) {
+		auto object_bytes = reinterpret_cast<char *>(const_cast<std::remove_cv_t<T> *>(cpp_object));
+		return *reinterpret_cast<MemberT *>(object_bytes + data.offset);
 	}
 
 
-	// Helper for creating objects when "new MyClass" is called from javascript
-	template<typename DefaultArgsTupleType, typename ... CONSTRUCTOR_PARAMETER_TYPES>
+	/**
+	 * Getter for members added with add_member_fast / add_member_snapshot
+	 */
+	template<class MemberT>
+	static void _fast_getter_helper(v8::Local<v8::Name> property,
+									v8::PropertyCallbackInfo<v8::Value> const & info) {
+		auto isolate = info.GetIsolate();
+		auto & data = *static_cast<FastMemberData *>(v8::Local<v8::External>::Cast(info.Data())->Value());
+		CallTimer timer(data.wrapper->member_metrics[data.member_id]);
+		try {
+			auto & member = fast_member_reference<MemberT>(fast_get_cpp_object(info.Holder(), data), data);
+			info.GetReturnValue().Set(CastToJS<std::add_lvalue_reference_t<MemberT>>()(isolate, member));
+		} catch (std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception reading {} data member: {}", xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+		}
+	}
+
+
+	/**
+	 * Setter for members added with add_member_fast
+	 */
+	template<class MemberT>
+	static void _fast_setter_helper(v8::Local<v8::Name> property,
+									v8::Local<v8::Value> value,
+									v8::PropertyCallbackInfo<void> const & info) {
+		auto isolate = info.GetIsolate();
+		auto & data = *static_cast<FastMemberData *>(v8::Local<v8::External>::Cast(info.Data())->Value());
+		CallTimer timer(data.wrapper->member_metrics[data.member_id]);
+		T * cpp_object;
+		try {
+			cpp_object = fast_get_cpp_object(info.Holder(), data);
+			fast_member_reference<MemberT>(cpp_object, data) = CastToNative<MemberT>()(isolate, value);
+		} catch (std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception setting {} data member: {}", xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+			return;
+		}
+
+		data.wrapper->notify_member_changed(info.Holder(), cpp_object, data.member_id, property, value);
+	}
+
+
+	/**
+	 * One C++ constructor signature callable from JavaScript
+	 */
+	template<typename ... CONSTRUCTOR_PARAMETER_TYPES>
+	struct ConstructorSignature {
+		static constexpr int js_parameter_count = (0 + ... + (parameter_uses_js_argument_v<CONSTRUCTOR_PARAMETER_TYPES> ? 1 : 0));
+
+		template<class DefaultArgsTuple>
+		static constexpr int required_js_parameter_count = js_parameter_count - static_cast<int>(std::tuple_size_v<DefaultArgsTuple>);
+
+		/**
+		 * Whether the number of arguments fits this signature and each one is the type of JavaScript value its
+		 *   parameter is normally built from
+		 */
+		template<class DefaultArgsTuple>
+		static bool matches(const v8::FunctionCallbackInfo<v8::Value> & info) {
+			if (info.Length() < required_js_parameter_count<DefaultArgsTuple> || info.Length() > js_parameter_count) {
+				return false;
+			}
+			int i = 0;
+			bool all_match = true;
+			((all_match = all_match && (!parameter_uses_js_argument_v<CONSTRUCTOR_PARAMETER_TYPES> || i >= info.Length() ||
+										js_value_matches_parameter<CONSTRUCTOR_PARAMETER_TYPES>(info[i++]))), ...);
+			return all_match;
+		}
+
+		template<class DefaultArgsTuple>
+		static T * construct(const v8::FunctionCallbackInfo<v8::Value> & info, DefaultArgsTuple const & default_args, ObjectArena * arena) {
+			return construct(info, default_args, arena, std::make_integer_sequence<int, sizeof...(CONSTRUCTOR_PARAMETER_TYPES)>{});
+		}
+
+		template<class DefaultArgsTuple, int... ArgIndexes>
+		static T * construct(const v8::FunctionCallbackInfo<v8::Value> & info, DefaultArgsTuple const & default_args, ObjectArena * arena,
+							 std::integer_sequence<int, ArgIndexes...>) {
+
+			// same default argument positions as CallCallable
+			constexpr int minimum_user_parameters_required =
+				static_cast<int>(sizeof...(CONSTRUCTOR_PARAMETER_TYPES)) - static_cast<int>(std::tuple_size_v<DefaultArgsTuple>);
+
+			int i = 0;
+			ParameterStorageFor<CONSTRUCTOR_PARAMETER_TYPES...> stuff;
+
+			// braced initialization guarantees the parameters are built left to right
+			std::tuple<CONSTRUCTOR_PARAMETER_TYPES...> parameters{
+				ParameterBuilder<CONSTRUCTOR_PARAMETER_TYPES>().template operator()<ArgIndexes - minimum_user_parameters_required, DefaultArgsTuple const &>(
+					info, i, stuff, default_args)...};
+
+			return std::apply([arena](auto && ... parameters) -> T * {
+				if (arena != nullptr) {
+					return arena->template create<T>(std::forward<decltype(parameters)>(parameters)...);
+				} else {
+					return new T(std::forward<decltype(parameters)>(parameters)...);
+				}
+			}, std::move(parameters));
+		}
+	};
+
+	template<class Signature>
+	struct constructor_signature_for;
+
+	template<class... CONSTRUCTOR_PARAMETER_TYPES>
+	struct constructor_signature_for<TypeList<CONSTRUCTOR_PARAMETER_TYPES...>> {
+		using type = ConstructorSignature<CONSTRUCTOR_PARAMETER_TYPES...>;
+	};
+
+
+	/**
+	 * Called when no signature's argument types matched.  Tries the first signature that can take that many arguments,
+	 *   since CastToNative may still be able to convert them, then a constructor taking the v8::FunctionCallbackInfo
+	 */
+	template<typename DefaultArgsTupleType, typename... Signatures>
+	static T * construct_from_closest_signature(const v8::FunctionCallbackInfo<v8::Value> & info,
+												DefaultArgsTupleType const & default_args, ObjectArena * arena) {
+		T * new_cpp_object = nullptr;
+		try {
+			(void)((new_cpp_object == nullptr &&
+					info.Length() >= Signatures::template required_js_parameter_count<DefaultArgsTupleType> &&
+					(new_cpp_object = Signatures::construct(info, default_args, arena)) != nullptr) || ...);
+		} catch(std::exception &) {
+			if constexpr(!constructed_from_callback_info_v<T>) {
+				throw;
+			}
+		}
+		if (new_cpp_object != nullptr) {
+			return new_cpp_object;
+		}
+
+		if constexpr(constructed_from_callback_info_v<T>) {
+			return construct_from_callback_info(info, arena);
+		} else {
+			throw InvalidCallException(fmt::format("No constructor for {} takes {} parameters", xl::demangle<T>(), info.Length()));
+		}
+	}
+
+
+	static T * construct_from_callback_info(const v8::FunctionCallbackInfo<v8::Value> & info, ObjectArena * arena) {
+		if (arena != nullptr) {
+			return arena->template create<T>(info);
+		} else {
+			return new T(info);
+		}
+	}
+
+
+	// Helper for creating objects when "new MyClass" is called from javascript.  The first signature whose
+	//   parameters match the JavaScript arguments is called
+	template<typename DefaultArgsTupleType, typename... Signatures>
 	static void v8_constructor(const v8::FunctionCallbackInfo<v8::Value>& info) {
 		auto isolate = info.GetIsolate();
 
-		// default arguments are in tuple
-		DefaultArgsTupleType * default_args_tuple_ptr =
-			static_cast<DefaultArgsTupleType *>(v8::Local<v8::External>::Cast(info.Data())->Value());
+		// default arguments are in tuple, shared by every call
+		auto const & default_args = *static_cast<DefaultArgsTupleType const *>(v8::Local<v8::External>::Cast(info.Data())->Value());
+
+		auto & wrapper = get_instance(isolate);
+		CallTimer timer(wrapper.constructor_metrics);
 
 		T * new_cpp_object = nullptr;
 
-		// Store a function which calls the constructor given the correct arguments
-		func::function<void(CONSTRUCTOR_PARAMETER_TYPES...)> constructor =
-				[&new_cpp_object](CONSTRUCTOR_PARAMETER_TYPES... info)->void{new_cpp_object = new T(std::forward<CONSTRUCTOR_PARAMETER_TYPES>(info)...);};
+		// if the current context has opted in to an arena, the object belongs to the arena instead of the GC
+		ObjectArena * arena = ObjectArena::get_active(isolate);
 
 		// route any cpp exceptions through javascript
 		try {
-			CallCallable<decltype(constructor)>()(constructor,
-												  info,
-												  std::make_integer_sequence<int, sizeof...(CONSTRUCTOR_PARAMETER_TYPES)>{},
-												  DefaultArgsTupleType(*default_args_tuple_ptr));
-
-		} catch(std::exception & e) {
-
-			if constexpr(constructed_from_callback_info_v<T>) {
-				new_cpp_object = new T(info);
-			} else {
+			try {
+				(void)((Signatures::template matches<DefaultArgsTupleType>(info) &&
+						(new_cpp_object = Signatures::construct(info, default_args, arena)) != nullptr) || ...);
+			} catch(std::exception &) {
+				// the matching signature couldn't build its parameters or its constructor threw
+				if constexpr(!constructed_from_callback_info_v<T>) {
+					throw;
+				} else {
+					new_cpp_object = construct_from_callback_info(info, arena);
+				}
+			}
 
-				log.error(LoggingSubjects::Subjects::RUNTIME_EXCEPTION,
-						  "Exception while running C++ constructor for {}: {}",
-						  xl::demangle<T>(), e.what());
-				isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
-				return;
+			if (new_cpp_object == nullptr) {
+				new_cpp_object = construct_from_closest_signature<DefaultArgsTupleType, Signatures...>(info, default_args, arena);
 			}
+		} catch(std::exception & e) {
+			timer.set_exception();
+			V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION,
+					  "Exception while running C++ constructor for {}: {}",
+					  xl::demangle<T>(), e.what());
+			isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+			return;
 		}
 
 
-		// if the object was created by calling new in javascript, it should be deleted when the garbage collector
-		//   GC's the javascript object, there should be no c++ references to it
-		auto & deleter = *v8toolkit::V8ClassWrapper<T>::get_instance(isolate).destructor_behavior_delete;
-
-		get_instance(isolate).initialize_new_js_object(isolate, info.This(), new_cpp_object, deleter);
+		if (arena != nullptr) {
+			// the arena destroys the object when it is destroyed, regardless of the javascript object
+			wrapper.initialize_new_js_object(isolate, info.This(), new_cpp_object, *wrapper.destructor_behavior_leave_alone, arena);
+		} else {
+			// if the object was created by calling new in javascript, it should be deleted when the garbage collector
+			//   GC's the javascript object, there should be no c++ references to it
+			wrapper.initialize_new_js_object(isolate, info.This(), new_cpp_object, *wrapper.destructor_behavior_delete);
+		}
 
 		// // return the object to the javascript caller
 		info.GetReturnValue().Set(info.This());
@@ -682,10 +1163,79 @@ private:
 	//   Useful because capturing lambdas don't have a traditional function pointer type
 	static void callback_helper(const v8::FunctionCallbackInfo<v8::Value>& args);
 
+	/**
+	 * Creates the function for a lazily installed method the first time it's looked up.  V8 replaces the lazy
+	 * property with the returned function, so this only runs once per prototype object.
+	 */
+	static void lazy_method_getter(v8::Local<v8::Name> property, v8::PropertyCallbackInfo<v8::Value> const & info);
+
+	/**
+	 * Puts a method calling `callback` on the prototype template, either as a function template or, if lazy
+	 * methods are enabled, as a property which creates the function when first looked up
+	 */
+	void add_prototype_method(v8::Local<v8::ObjectTemplate> prototype_template,
+							  std::string_view method_name,
+							  StdFunctionCallbackType * callback);
+
+
+	// returns the header of the WrappedData object from the InternalField inside the provided object.  The
+	//   object may have been created by the wrapper for a derived type, so only the header is available
+	static WrappedObjectHeader & get_wrapped_data(v8::Local<v8::Object> object);
+
+
+	/**
+	 * Called when a JavaScript object created by this wrapper is garbage collected.  Cleans up the c++ object
+	 *   according to its DestructorBehavior and returns the WrappedData block to the pool
+	 */
+	static void wrapped_object_weak_callback(v8::WeakCallbackInfo<WrappedData<T>> const & info);
+
+	/**
+	 * Removes all references to the WrappedData and returns it to the pool.  Does not touch the c++ object.
+	 */
+	static void forget_wrapped_data(v8::Isolate * isolate, WrappedData<T> * wrapped_data);
+
+	/**
+	 * Called by an ObjectArena before destroying the c++ object in the provided WrappedData.  If the javascript
+	 *   object is still alive, it no longer refers to any c++ object afterwards.
+	 */
+	static void detach_arena_wrapped_data(v8::Isolate * isolate, WrappedObjectHeader * wrapped_data);
+
+	static int64_t get_external_size(T * cpp_object) {
+		// ExternalSize works on the unqualified type, even for objects of volatile-qualified wrapped types
+		return static_cast<int64_t>(external_size(*const_cast<std::remove_cv_t<T> *>(cpp_object)));
+	}
+
+	static int64_t get_external_size(AnyBase * native_object) {
+		return get_external_size(static_cast<AnyPtr<T> *>(native_object)->get());
+	}
+
+	static void report_external_size(v8::Isolate * isolate, WrappedObjectHeader & wrapped_data) {
+		auto new_size = wrapped_data.compute_external_size(wrapped_data.native_object);
+		isolate->AdjustAmountOfExternalAllocatedMemory(new_size - wrapped_data.external_size);
+		wrapped_data.update_census(-1);
+		wrapped_data.external_size = new_size;
+		wrapped_data.update_census(1);
+	}
 
-	// returns the WrappedData<T> object from the InternalField inside the provided object, or nullptr if
-	//   not available
-	static WrappedData<T> & get_wrapped_data(v8::Local<v8::Object> object);
+	void link_live_wrapped_data(WrappedObjectHeader * wrapped_data) {
+		wrapped_data->next_live = this->live_wrapped_data;
+		if (this->live_wrapped_data != nullptr) {
+			this->live_wrapped_data->previous_live = wrapped_data;
+		}
+		this->live_wrapped_data = wrapped_data;
+	}
+
+	void unlink_live_wrapped_data(WrappedObjectHeader * wrapped_data) {
+		if (wrapped_data->previous_live != nullptr) {
+			wrapped_data->previous_live->next_live = wrapped_data->next_live;
+		} else {
+			this->live_wrapped_data = wrapped_data->next_live;
+		}
+		if (wrapped_data->next_live != nullptr) {
+			wrapped_data->next_live->previous_live = wrapped_data->previous_live;
+		}
+		wrapped_data->previous_live = wrapped_data->next_live = nullptr;
+	}
 
 public:
 
@@ -698,13 +1248,33 @@ public:
 		result << fmt::format("finalized: {}", this->finalized) << std::endl;
 		result << fmt::format("Constructing FunctionTemplates created: {}", this->this_class_function_templates.size()) << std::endl;
 		result << fmt::format("methods added: {}", this->method_adders.size()) << std::endl;
+		if (this->lazy_methods_flag) {
+			auto materializations = this->get_lazy_method_materializations();
+			auto used = std::count_if(materializations.begin(), materializations.end(), [](auto & pair){return pair.second > 0;});
+			result << fmt::format("lazy methods used: {} of {}", used, materializations.size()) << std::endl;
+		}
 		result << fmt::format("static elements added: {}", this->static_adders.size()) << std::endl;
 		result << fmt::format("data members added: {}", this->member_adders.size()) << std::endl;
 		result << fmt::format("property changed callbacks registered: {}", this->property_changed_callbacks.size()) << std::endl;
+		auto census = this->get_census();
+		result << fmt::format("live owning objects: {} ({} external bytes)", census.owning_objects, census.owning_external_bytes) << std::endl;
+		result << fmt::format("live non-owning objects: {} ({} external bytes)", census.non_owning_objects, census.non_owning_external_bytes) << std::endl;
+		result << fmt::format("existing wrapped objects: {}", census.existing_wrapped_objects) << std::endl;
 		return result.str();
 	}
 
 
+	/**
+	 * Returns the counts and external sizes of JavaScript objects created by this wrapper which are still alive
+	 */
+	WrappedObjectCensus get_census() const {
+		auto result = this->census;
+		result.class_name = this->class_name;
+		result.existing_wrapped_objects = this->existing_wrapped_objects.size();
+		return result;
+	}
+
+
 
 	DestructorBehavior * destructor_behavior_delete = new DestructorBehavior_Delete<T>(); // unique_ptr too expensive to compile
 	DestructorBehavior * destructor_behavior_leave_alone = new DestructorBehavior_LeaveAlone(); // unique_ptr too expensive to compile
@@ -725,6 +1295,86 @@ public:
      */
     void register_callback(PropertyChangedCallback callback);
 
+
+	/**
+	 * Registers a callback to be called when any data member is assigned from JavaScript, identified by MemberId
+	 * instead of by name.  If batching is enabled, changes are queued and delivered by drain_member_changes instead.
+	 */
+	void register_member_changed_callback(MemberChangedCallback callback) {
+		this->member_changed_callbacks.push_back(std::move(callback));
+	}
+
+
+	/**
+	 * Returns the MemberId for a data member added to this wrapper
+	 * @param member_name name the member was added with
+	 * @return MemberId for the member
+	 */
+	MemberId get_member_id(std::string_view member_name) const {
+		auto found = std::find(this->member_names.begin(), this->member_names.end(), member_name);
+		if (found == this->member_names.end()) {
+			throw InvalidCallException(fmt::format("No data member named '{}' in class '{}'", member_name, this->class_name));
+		}
+		return static_cast<MemberId>(found - this->member_names.begin());
+	}
+
+
+	/**
+	 * Returns the name of the data member with the given MemberId
+	 */
+	std::string const & get_member_name(MemberId member_id) const {
+		return this->member_names.at(member_id);
+	}
+
+
+	/**
+	 * Turns batching of member change notifications on or off.  While on, assignments from JavaScript queue a
+	 * MemberChange instead of calling member changed callbacks.  Repeated assignments to the same member of the
+	 * object most recently changed are only queued once.  The queue grows as needed.
+	 * The embedder must drain the queue before any of the queued objects are destroyed.
+	 * @param enabled whether to batch changes
+	 * @param initial_capacity number of changes which can be queued before the queue must grow
+	 */
+	void set_member_change_batching(bool enabled, size_t initial_capacity = 1024) {
+		this->batch_member_changes = enabled;
+#ifdef USE_EASTL_FOR_INTERNALS
+		if (enabled && this->pending_member_changes.capacity() < initial_capacity) {
+			this->pending_member_changes.set_capacity(initial_capacity);
+		}
+#endif
+	}
+
+
+	/**
+	 * Delivers all queued member changes, oldest first, to the callback and empties the queue
+	 * @param callback called with each T * and MemberId
+	 * @return number of changes delivered
+	 */
+	template<class Callback>
+	size_t drain_member_changes(Callback && callback) {
+		size_t count = 0;
+		while (!this->pending_member_changes.empty()) {
+			auto change = this->pending_member_changes.front();
+			this->pending_member_changes.pop_front();
+			callback(change.cpp_object, change.member_id);
+			count++;
+		}
+		return count;
+	}
+
+
+	/**
+	 * Delivers all queued member changes to the callbacks registered with register_member_changed_callback
+	 * @return number of changes delivered
+	 */
+	size_t drain_member_changes() {
+		return this->drain_member_changes([this](T * cpp_object, MemberId member_id) {
+			for (auto & callback : this->member_changed_callbacks) {
+				callback(this->isolate, cpp_object, member_id);
+			}
+		});
+	}
+
 	/**
 	 * Object still has the memory, it just doesn't own it.  It may or may not have owned it before, but now
 	 * it doesn't.  For example, this is called passing an object to a C++ function taking a parameter type of a
@@ -754,15 +1404,48 @@ public:
 			}
 		}
 
-		wrapped_data.weak_callback_data->global.ClearWeak();
+		// the weak callback will never run, so the javascript object stays alive for as long as the
+		//   WrappedData remains in the live list
+		wrapped_data.global.ClearWeak();
+		wrapped_data.update_census(-1);
+		wrapped_data.destructor_behavior = nullptr;
 
-		// since the weak callback won't run to delete the SetWeakCallbackData memory, do that now
-		delete wrapped_data.weak_callback_data;
-		wrapped_data.weak_callback_data = nullptr;
+		// whatever now owns the memory is responsible for it
+		this->isolate->AdjustAmountOfExternalAllocatedMemory(-wrapped_data.external_size);
+		wrapped_data.external_size = 0;
+		wrapped_data.update_census(1);
 
 		return V8ClassWrapper<T>::get_cpp_object(object);
 	}
 
+
+	/**
+	 * Recomputes ExternalSize for the C++ object inside the given JavaScript object and reports the difference
+	 * to V8.  Call after the object has grown or shrunk significantly.  The size is computed for the type the
+	 * object was wrapped as, so an object created by the wrapper for a type derived from T uses that type's
+	 * ExternalSize.
+	 * @param object JavaScript object wrapping a C++ object compatible with T
+	 */
+	void update_external_size(v8::Local<v8::Object> object) {
+		report_external_size(this->isolate, get_wrapped_data(object));
+	}
+
+
+	/**
+	 * Recomputes ExternalSize for the given C++ object and reports the difference to V8 if it is currently
+	 * wrapped by a JavaScript object created by this wrapper.
+	 * @param cpp_object C++ object which may have changed size
+	 * @return whether a JavaScript object was found for the C++ object
+	 */
+	bool update_external_size(T * cpp_object) {
+		auto existing_wrapped_object = this->existing_wrapped_objects.find(cpp_object);
+		if (existing_wrapped_object == this->existing_wrapped_objects.end()) {
+			return false;
+		}
+		report_external_size(this->isolate, *existing_wrapped_object->second);
+		return true;
+	}
+
     /**
      * Returns true if the destructor associated with the object has a destructive() static method which returns true.
      * In general, this means that when the object is garbage collected in JavaScript that the C++ object will be destroyed.
@@ -772,20 +1455,14 @@ public:
      * @return whether the object "owns" the memory or not.
      */
     static bool does_object_own_memory(v8::Local<v8::Object> object) {
-        WrappedData<T> & wrapped_data = get_wrapped_data(object);
+        WrappedObjectHeader & wrapped_data = get_wrapped_data(object);
 
-//		std::cerr << fmt::format("Does object own memory?  ptr: {}, weak callback data: {} type: {}, wrapped_data: {}",
+//		std::cerr << fmt::format("Does object own memory?  ptr: {}, destructor behavior: {} type: {}, wrapped_data: {}",
 //                                 (void*)wrapped_data.native_object,
-//                                 (void*)wrapped_data.weak_callback_data,
+//                                 (void*)wrapped_data.destructor_behavior,
 //                                 xl::demangle<T>(),
 //                                 (void*)&wrapped_data) << std::endl;
-//
-//		if (wrapped_data.weak_callback_data) {
-//			std::cerr << fmt::format("callback data destructive? {}", wrapped_data.weak_callback_data->destructive) << std::endl;
-//		}
-        bool result =  wrapped_data.weak_callback_data != nullptr && wrapped_data.weak_callback_data->destructive;
-
-        return result;
+        return wrapped_data.owns_memory();
     }
 
     /**
@@ -794,11 +1471,14 @@ public:
      * @param js_object newly-created JavaScript object
      * @param cpp_object the C++ object to be wrapped by the JavaScript object
      * @param destructor_behavior the DestructorBehavior to use for this object.
+     * @param arena if specified, cpp_object was created in this arena and is destroyed by it instead of by the
+     *   garbage collector
      */
 	void initialize_new_js_object(v8::Isolate * isolate,
 										 v8::Local<v8::Object> js_object,
 										 T * cpp_object,
-										 DestructorBehavior const & destructor_behavior)
+										 DestructorBehavior const & destructor_behavior,
+										 ObjectArena * arena = nullptr)
 	{
 #ifdef V8_CLASS_WRAPPER_DEBUG
         fprintf(stderr, "Initializing new js object for %s for v8::object at %p and cpp object at %p\n",  xl::demangle<T>().c_str(), *js_object, cpp_object);
@@ -809,17 +1489,18 @@ public:
 		assert(js_object->InternalFieldCount() >= 1);
 
 
-		auto weak_callback_data = v8toolkit::global_set_weak(
-			isolate,
-			js_object,
-			[isolate, cpp_object, &destructor_behavior](v8::WeakCallbackInfo<SetWeakCallbackData> const & info) {
-				destructor_behavior(isolate, cpp_object);
-			},
-			destructor_behavior.destructive()
-		);
-
+		// single allocation holding the type information, weak handle, and destructor behavior for the object
+		auto wrapped_data = this->wrapped_data_pool.create(cpp_object, destructor_behavior);
+		this->link_live_wrapped_data(wrapped_data);
 
-		auto wrapped_data = new WrappedData<T>(cpp_object, weak_callback_data);
+		wrapped_data->global.Reset(isolate, js_object);
+		if (arena != nullptr) {
+			// no callback - the handle is just cleared if the javascript object is collected before the arena
+			wrapped_data->global.SetWeak();
+			arena->set_wrapped_data(cpp_object, wrapped_data, &V8ClassWrapper<T>::detach_arena_wrapped_data);
+		} else {
+			wrapped_data->global.SetWeak(wrapped_data, &V8ClassWrapper<T>::wrapped_object_weak_callback, v8::WeakCallbackType::kParameter);
+		}
 
 #ifdef V8_CLASS_WRAPPER_DEBUG
 
@@ -827,13 +1508,17 @@ public:
 #endif
 
 
-		js_object->SetInternalField(0, v8::External::New(isolate, wrapped_data));
+		js_object->SetInternalField(0, v8::External::New(isolate, static_cast<WrappedObjectHeader *>(wrapped_data)));
 
 		// tell V8 about the memory we allocated so it knows when to do garbage collection
-		isolate->AdjustAmountOfExternalAllocatedMemory(sizeof(T));
+		wrapped_data->compute_external_size = &V8ClassWrapper<T>::get_external_size;
+		wrapped_data->external_size = get_external_size(cpp_object);
+		isolate->AdjustAmountOfExternalAllocatedMemory(wrapped_data->external_size);
+
+		wrapped_data->census = &this->census;
+		wrapped_data->update_census(1);
 
-		this->existing_wrapped_objects.emplace(cpp_object,
-											   v8::Global<v8::Object>(isolate, js_object));
+		this->existing_wrapped_objects.emplace(cpp_object, wrapped_data);
 
 		V8TOOLKIT_DEBUG("Inserting new %s object at %p into existing_wrapped_objects hash that is now of size: %d\n",  xl::demangle<T>().c_str(), cpp_object, (int)this->existing_wrapped_objects.size());
 
@@ -877,6 +1562,15 @@ public:
         // forces object to be re-created next time an instance is requested
         isolate_to_wrapper_map.erase(isolate);
 
+		// weak callbacks must not fire into the pool after it is gone
+		for (auto wrapped_data = this->live_wrapped_data; wrapped_data != nullptr; wrapped_data = wrapped_data->next_live) {
+			wrapped_data->global.Reset();
+		}
+		this->live_wrapped_data = nullptr;
+		this->existing_wrapped_objects.clear();
+		this->wrapped_data_pool.release_all();
+		this->census = WrappedObjectCensus{this->class_name};
+
         // "global" names in the isolate also become available again
         used_constructor_name_list_map.erase(isolate);
 	}
@@ -905,6 +1599,33 @@ public:
     void set_class_name(const std::string & name);
 
 
+	/**
+	 * Creates each prototype method the first time it's looked up instead of creating all of them whenever a
+	 * context is created.  Saves startup time and memory for classes with many methods of which scripts only use
+	 * a few.  Must be called before finalize.
+	 */
+	void set_lazy_methods(bool lazy_methods = true) {
+		assert(!this->finalized);
+		if constexpr(!std::is_const_v<T> && is_wrapped_type_v<ConstT>) {
+			V8ClassWrapper<ConstT>::get_instance(this->isolate).set_lazy_methods(lazy_methods);
+		}
+		this->lazy_methods_flag = lazy_methods;
+	}
+
+
+	/**
+	 * For lazily installed methods, returns how many prototype objects each one has been created on - methods with
+	 * a count of 0 have never been used
+	 */
+	MapT<std::string, uint32_t> get_lazy_method_materializations() const {
+		MapT<std::string, uint32_t> result;
+		for (auto & data : this->lazy_method_data) {
+			result[std::string(data.method_name)] += data.materializations;
+		}
+		return result;
+	}
+
+
 
     /**
     * Species other types that can be substituted for T when calling a function expecting T
@@ -975,6 +1696,9 @@ public:
 
 
 
+		// a lazily registered parent must be registered first
+		V8ClassWrapper<ParentType>::get_instance(isolate).run_lazy_registration();
+
 		if (!V8ClassWrapper<ParentType>::get_instance(isolate).is_finalized()) {
 			fprintf(stderr, "Tried to set parent type of %s to unfinalized %s\n",
 					 xl::demangle<T>().c_str(),  xl::demangle<ParentType>().c_str());
@@ -1000,6 +1724,11 @@ public:
 	/**
 	* Creates a javascript method with the specified name inside `parent_template` which, when called with the "new" keyword, will return
 	*   a new object of this type.
+	*
+	* For a class with several constructors, specify each signature as a TypeList:
+	*   add_constructor<TypeList<int>, TypeList<std::string const &, int>>("Name", parent_template)
+	* The first signature whose argument count and JavaScript argument types match is called.  Default arguments
+	*   can only be given for a single signature.
 	*/
 	template<typename ... CONSTRUCTOR_PARAMETER_TYPES, class DefaultArgsTuple = std::tuple<>>
 	void add_constructor(const std::string & js_constructor_name,
@@ -1009,9 +1738,7 @@ public:
 	    assert(((void)"Type must be finalized before calling add_constructor", this->finalized) == true);
 		check_if_constructor_name_used(js_constructor_name);
 
-	    auto constructor_template =
-		make_wrapping_function_template(&V8ClassWrapper<T>::template v8_constructor<DefaultArgsTuple, CONSTRUCTOR_PARAMETER_TYPES...>,
-						v8::External::New(this->isolate, new DefaultArgsTuple(std::move(default_args))));
+	    auto constructor_template = this->make_constructor_template<CONSTRUCTOR_PARAMETER_TYPES...>(js_constructor_name, default_args);
 
 	    // Add the constructor function to the parent object template (often the global template)
 //	    std::cerr << "Adding constructor to global with name: " << js_constructor_name << std::endl;
@@ -1019,6 +1746,125 @@ public:
 	}
 
 
+	/**
+	 * Defers the class's registration code - adding its members and methods, setting its parent type and calling
+	 * finalize - until the class is first needed: when a constructor added with add_lazy_constructor is first looked
+	 * up, when it's set as the parent type of another class, or when an object of the type is first wrapped.
+	 * Classes scripts never use are never registered.
+	 *
+	 * The registration must call finalize.  No other changes may be made to the wrapper until it has run.
+	 */
+	void set_lazy_registration(func::function<void(V8ClassWrapper &)> registration) {
+		assert(!this->finalized);
+		this->lazy_registration = std::move(registration);
+	}
+
+
+	/**
+	 * Runs the registration set with set_lazy_registration if it hasn't been run yet
+	 */
+	void run_lazy_registration() {
+		if constexpr(std::is_const_v<T>) {
+			// const wrappers are set up by the registration of the non-const type
+			V8ClassWrapper<std::remove_const_t<T>>::get_instance(this->isolate).run_lazy_registration();
+		}
+		if (this->lazy_registration) {
+			// cleared first so anything the registration does which needs it registered doesn't run it again
+			auto registration = std::move(this->lazy_registration);
+			this->lazy_registration = nullptr;
+			registration(*this);
+			if (!this->finalized) {
+				throw InvalidCallException(fmt::format("Lazy registration for {} didn't call finalize", xl::demangle<T>()));
+			}
+		}
+	}
+
+
+	/**
+	 * Like add_constructor, but the constructor is put on `parent_template` as a lazy property and the class's
+	 * lazy registration, and the creation of its FunctionTemplate, don't happen until a script first looks up the
+	 * constructor name.  May be called before the registration has run.
+	 */
+	template<typename ... CONSTRUCTOR_PARAMETER_TYPES, class DefaultArgsTuple = std::tuple<>>
+	void add_lazy_constructor(const std::string & js_constructor_name,
+							  v8::Local<v8::ObjectTemplate> parent_template,
+							  DefaultArgsTuple const & default_args = DefaultArgsTuple())
+	{
+		check_if_constructor_name_used(js_constructor_name);
+
+		struct LazyConstructor {
+			std::string js_constructor_name;
+			DefaultArgsTuple default_args;
+
+			// shared by every context created from parent_template
+			v8::Global<v8::FunctionTemplate> constructor_template;
+		};
+
+		// like the default arguments of eagerly added constructors, lives as long as the isolate
+		auto lazy_constructor = new LazyConstructor{js_constructor_name, default_args};
+
+		parent_template->SetLazyDataProperty(
+			v8::String::NewFromUtf8(isolate, js_constructor_name.c_str()),
+			[](v8::Local<v8::Name>, v8::PropertyCallbackInfo<v8::Value> const & info) {
+				auto isolate = info.GetIsolate();
+				auto lazy_constructor = static_cast<LazyConstructor *>(v8::External::Cast(*(info.Data()))->Value());
+				try {
+					auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
+					wrapper.run_lazy_registration();
+					if (!wrapper.is_finalized()) {
+						throw InvalidCallException(fmt::format("Lazy constructor {} used but {} was never finalized",
+															   lazy_constructor->js_constructor_name, xl::demangle<T>()));
+					}
+					if (lazy_constructor->constructor_template.IsEmpty()) {
+						lazy_constructor->constructor_template.Reset(isolate,
+							wrapper.template make_constructor_template<CONSTRUCTOR_PARAMETER_TYPES...>(
+								lazy_constructor->js_constructor_name, lazy_constructor->default_args));
+					}
+					v8::Local<v8::Function> constructor;
+					if (lazy_constructor->constructor_template.Get(isolate)->GetFunction(isolate->GetCurrentContext()).ToLocal(&constructor)) {
+						info.GetReturnValue().Set(constructor);
+					}
+				} catch (std::exception & e) {
+					V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while registering {} lazily: {}",
+							  xl::demangle<T>(), e.what());
+					isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
+				}
+			},
+			v8::External::New(isolate, lazy_constructor));
+	}
+
+
+private:
+
+	/**
+	 * Creates the FunctionTemplate for a JavaScript constructor function calling the constructor(s) of T with the
+	 * given signature(s)
+	 */
+	template<typename ... CONSTRUCTOR_PARAMETER_TYPES, class DefaultArgsTuple>
+	v8::Local<v8::FunctionTemplate> make_constructor_template(const std::string & js_constructor_name,
+															  DefaultArgsTuple const & default_args)
+	{
+		if (this->constructor_metrics == nullptr) {
+			this->constructor_metrics = this->add_call_metrics(js_constructor_name, CallKind::Constructor);
+		}
+
+		v8::FunctionCallback constructor_callback;
+		if constexpr(sizeof...(CONSTRUCTOR_PARAMETER_TYPES) > 0 && (xl::is_template_for_v<TypeList, CONSTRUCTOR_PARAMETER_TYPES> && ...)) {
+			static_assert(std::tuple_size_v<DefaultArgsTuple> == 0, "Default arguments can only be given for a single constructor signature");
+			constructor_callback = &V8ClassWrapper<T>::template v8_constructor<DefaultArgsTuple,
+				typename constructor_signature_for<CONSTRUCTOR_PARAMETER_TYPES>::type...>;
+		} else {
+			constructor_callback = &V8ClassWrapper<T>::template v8_constructor<DefaultArgsTuple,
+				ConstructorSignature<CONSTRUCTOR_PARAMETER_TYPES...>>;
+		}
+
+	    return make_wrapping_function_template(constructor_callback,
+											   v8::External::New(this->isolate, new DefaultArgsTuple(default_args)));
+	}
+
+public:
+
+
 	/**
 	 * When you don't want a "constructor" but you still need something to attach the static method names to, use this
 	 * instead of add_constructor
@@ -1059,13 +1905,19 @@ public:
     * \code{cpp}
     * add_variable(context, context->GetGlobal(), "js_name", class_wrapper.wrap_existing_cpp_object(context, some_c++_object));
     * \endcode
+    * @param instance_constructor if a new JavaScript object is created, it's created by this function instead of the
+    * class's own, such as one returned from make_subclass_instance_constructor
 	*/
-	v8::Local<v8::Object> wrap_existing_cpp_object(v8::Local<v8::Context> context, T * existing_cpp_object, DestructorBehavior & destructor_behavior, bool force_wrap_this_type = false)
+	v8::Local<v8::Object> wrap_existing_cpp_object(v8::Local<v8::Context> context, T * existing_cpp_object, DestructorBehavior & destructor_behavior, bool force_wrap_this_type = false,
+												   v8::Local<v8::Function> instance_constructor = v8::Local<v8::Function>())
 	{
 		// TODO: Expensive - when combined with add_method -- maybe try and move this out of V8ClassWrapper?
 		auto isolate = this->isolate;
         assert(existing_cpp_object != nullptr);
 
+		// a lazily registered class is registered when its first object is wrapped, even if that's from C++
+		this->run_lazy_registration();
+
         // if it's not finalized, try to find an existing CastToJS conversion because it's not a wrapped class
 	    //*** IF YOU ARE HERE LOOKING AT AN INFINITE RECURSION CHECK THE TYPE IS ACTUALLY WRAPPED ***
 	    if (!this->is_finalized()) {
@@ -1081,9 +1933,17 @@ public:
 		// if there's currently a javascript object wrapping this pointer, return that instead of making a new one
         //   This makes sure if the same object is returned multiple times, the javascript object is also the same
 		v8::Local<v8::Object> javascript_object;
-		if(this->existing_wrapped_objects.find(existing_cpp_object) != this->existing_wrapped_objects.end()) {
+		auto existing_wrapped_object = this->existing_wrapped_objects.find(existing_cpp_object);
+
+		// ObjectArena objects don't get a weak callback, so their javascript object may be gone already
+		if (existing_wrapped_object != this->existing_wrapped_objects.end() && existing_wrapped_object->second->global.IsEmpty()) {
+			this->existing_wrapped_objects.erase(existing_wrapped_object);
+			existing_wrapped_object = this->existing_wrapped_objects.end();
+		}
+
+		if(existing_wrapped_object != this->existing_wrapped_objects.end()) {
 			V8TOOLKIT_DEBUG("Found existing javascript object for c++ object %p - %s\n", (void*)existing_cpp_object, v8toolkit:: xl::demangle<T>().c_str());
-			javascript_object = v8::Local<v8::Object>::New(isolate, this->existing_wrapped_objects[existing_cpp_object]);
+			javascript_object = v8::Local<v8::Object>::New(isolate, existing_wrapped_object->second->global);
 
 		} else {
 
@@ -1101,11 +1961,14 @@ public:
 #endif
 
 
-			if (this->wrap_as_most_derived_flag && !force_wrap_this_type) {
+			if (this->wrap_as_most_derived_flag && !force_wrap_this_type && instance_constructor.IsEmpty()) {
                 javascript_object = this->wrap_as_most_derived(existing_cpp_object, destructor_behavior);
             } else {
                 v8::TryCatch tc(isolate);
-				javascript_object = get_function_template()->GetFunction(context).ToLocalChecked()->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
+				if (instance_constructor.IsEmpty()) {
+					instance_constructor = get_function_template()->GetFunction(context).ToLocalChecked();
+				}
+				javascript_object = instance_constructor->NewInstance(isolate->GetCurrentContext()).ToLocalChecked();
 
 
 				// this shouldn't be able to fire because the FunctionTemplate being used shouldn't have a constructor
@@ -1127,6 +1990,31 @@ public:
 	}
 
 
+	/**
+	 * Returns a function creating JavaScript objects wrapping T whose prototype is `prototype` from the start, for
+	 * types extended in JavaScript.  All objects created by the same function share a hidden class, unlike objects
+	 * whose prototype is changed after they're created, which V8 moves off its fast paths.
+	 * The data members and type checks of T's own objects are inherited, methods come from `prototype`'s chain.
+	 */
+	v8::Local<v8::Function> make_subclass_instance_constructor(v8::Local<v8::Context> context, v8::Local<v8::Object> prototype) {
+		assert(this->finalized);
+
+		auto subclass_template = v8::FunctionTemplate::New(this->isolate);
+		subclass_template->Inherit(this->get_function_template());
+
+		auto instance_template = subclass_template->InstanceTemplate();
+		instance_template->SetInternalFieldCount(1);
+		if (callable_adder.callback) {
+			instance_template->SetCallAsFunctionHandler(callback_helper,
+														v8::External::New(this->isolate, &callable_adder.callback));
+		}
+
+		auto constructor = subclass_template->GetFunction(context).ToLocalChecked();
+		(void)constructor->Set(context, make_js_key(this->isolate, V8TOOLKIT_STRING_KEY("prototype")), prototype);
+		return constructor;
+	}
+
+
 	// this form is required for selecting between different overloaded instances of the same function name
 	// NOTE: If this doesn't match something, make sure it's not a function TEMPLATE instead of a function -- i.e. missing template parameters
 	template<class R, class... Params, class DefaultArgs = std::tuple<>>
@@ -1194,22 +2082,25 @@ public:
 		this->check_if_static_name_used(method_name);
 
 
-		auto static_method_adder = [this, method_name, callable, default_args_tuple](v8::Local<v8::FunctionTemplate> constructor_function_template) {
+		auto metrics = this->add_call_metrics(method_name, CallKind::StaticMethod);
+		auto static_method_adder = [this, method_name, callable, default_args_tuple, metrics](v8::Local<v8::FunctionTemplate> constructor_function_template) {
 
 			// the function called is this capturing lambda, which calls the actual function being registered
 			auto static_method_function_template =
-				v8toolkit::make_function_template(this->isolate, [this, default_args_tuple, callable, method_name](const v8::FunctionCallbackInfo<v8::Value>& info) {
+				v8toolkit::make_function_template(this->isolate, [this, default_args_tuple, callable, method_name, metrics](const v8::FunctionCallbackInfo<v8::Value>& info) {
 
+					CallTimer timer(metrics);
 					try {
 						function_type_t<Callable> callable_func(callable);
-						log.info(LogT::Subjects::WRAPPED_FUNCTION_CALL, "Calling static function {}::{}", xl::demangle<T>(), method_name);
+						V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_FUNCTION_CALL, "Calling static function {}::{}", xl::demangle<T>(), method_name);
 						CallCallable<decltype(callable_func)>()(
 							callable_func,
 							info,
 							get_index_sequence_for_func_function(callable_func),
 							default_args_tuple);
 					} catch (std::exception & e) {
-						log.error(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running static method {}::{}: {}",
+						timer.set_exception();
+						V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running static method {}::{}: {}",
 								    xl::demangle<T>(), method_name, e.what());
 						isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
 						return;
@@ -1259,14 +2150,16 @@ public:
         }
 
         this->check_if_name_used(member_name);
+        auto member_id = this->intern_member_name(member_name);
 
         // store a function for adding the member on to an object template in the future
-        member_adders.emplace_back([member_name](v8::Local<v8::ObjectTemplate> & constructor_template){
+        member_adders.emplace_back([this, member_name, member_id](v8::Local<v8::ObjectTemplate> & constructor_template){
 
 
             constructor_template->SetAccessor(v8::Local<v8::Name>::Cast(make_js_string(member_name)),
                                               _getter_helper<reference_getter>,
-                                              _setter_helper<reference_getter>);
+                                              _setter_helper<reference_getter>,
+                                              v8::Integer::NewFromUnsigned(this->isolate, member_id));
         });
     }
 
@@ -1293,12 +2186,14 @@ public:
 		}
 
 		this->check_if_name_used(member_name);
+		auto member_id = this->intern_member_name(member_name);
 
-		member_adders.emplace_back([member_name](v8::Local<v8::ObjectTemplate> & constructor_template){
+		member_adders.emplace_back([this, member_name, member_id](v8::Local<v8::ObjectTemplate> & constructor_template){
 
 			constructor_template->SetAccessor(make_js_string(member_name),
 											  _getter_helper<reference_getter>,
-											  0);
+											  0,
+											  v8::Integer::NewFromUnsigned(this->isolate, member_id));
 		});
 	}
 
@@ -1314,6 +2209,111 @@ public:
 	};
 
 
+	/**
+	 * Like add_member, but for random-access container data members such as std::vector, std::deque, and std::array.
+	 * Instead of copying the entire container into a new JavaScript array on every access, the property returns a
+	 * ContainerView which reads (and optionally writes) elements of the live C++ container as they are accessed.
+	 * The view keeps the JavaScript object it was read from alive.
+	 * @tparam member pointer to data member
+	 * @param member_name JavaScript property name
+	 * @param writable whether JavaScript may assign to existing elements of the container.  Never true for const T
+	 */
+	template<auto member>
+	void add_member_view(std::string_view member_name, bool writable = false) {
+		assert(this->finalized == false);
+
+		if constexpr(!std::is_const_v<T> && is_wrapped_type_v<std::add_const_t<T>>) {
+			V8ClassWrapper<ConstT>::get_instance(isolate).template add_member_view<member>(member_name, false);
+		}
+
+		this->check_if_name_used(member_name);
+		auto member_id = this->intern_member_name(member_name);
+
+		member_adders.emplace_back([this, name = std::string(member_name), member_id, writable](v8::Local<v8::ObjectTemplate> & object_template){
+			object_template->SetAccessor(v8::Local<v8::Name>::Cast(make_js_string(name)),
+										 writable ? _view_getter_helper<member, true> : _view_getter_helper<member, false>,
+										 nullptr,
+										 v8::Integer::NewFromUnsigned(this->isolate, member_id));
+		});
+	}
+
+
+	/**
+	 * Like add_member, but for data members of standard layout types holding non-wrapped values.  The accessors
+	 * locate the member by its offset and skip the TypeChecker when the JavaScript object was created for exactly
+	 * this type.
+	 * @tparam member pointer to data member
+	 * @param member_name JavaScript property name
+	 */
+	template<auto member>
+	void add_member_fast(std::string_view member_name) {
+		this->_add_fast_member<member>(member_name, false, false);
+	}
+
+
+	/**
+	 * Read-only version of add_member_fast
+	 */
+	template<auto member>
+	void add_member_fast_readonly(std::string_view member_name) {
+		this->_add_fast_member<member>(member_name, true, false);
+	}
+
+
+	/**
+	 * Adds a read-only data member which is read from the C++ object the first time it is accessed on each
+	 * JavaScript object and is a plain JavaScript data property from then on.  Changes made to the C++ member after
+	 * the first access are not visible from JavaScript.
+	 */
+	template<auto member>
+	void add_member_snapshot(std::string_view member_name) {
+		this->_add_fast_member<member>(member_name, true, true);
+	}
+
+
+private:
+
+	template<auto member>
+	void _add_fast_member(std::string_view member_name, bool readonly, bool snapshot) {
+		assert(this->finalized == false);
+		using MemberT = std::remove_reference_t<decltype(std::declval<std::remove_cv_t<T> &>().*member)>;
+		static_assert(!is_wrapped_type_v<std::remove_cv_t<MemberT>>, "Fast member access is only for non-wrapped member types, use add_member");
+
+		// mirror add_member by always making the member available on the const type, too
+		if constexpr(!std::is_const_v<T> && is_wrapped_type_v<std::add_const_t<T>>) {
+			auto & const_wrapper = V8ClassWrapper<ConstT>::get_instance(isolate);
+			if (snapshot) {
+				const_wrapper.template add_member_snapshot<member>(member_name);
+			} else {
+				const_wrapper.template add_member_fast_readonly<member>(member_name);
+			}
+		}
+
+		this->check_if_name_used(member_name);
+
+		auto & data = this->fast_member_data.emplace_back(FastMemberData{member_offset<member>(), this, this->intern_member_name(member_name)});
+
+		member_adders.emplace_back([this, name = std::string(member_name), &data, readonly, snapshot](v8::Local<v8::ObjectTemplate> & object_template){
+			auto js_name = v8::Local<v8::Name>::Cast(make_js_string(name));
+			auto external = v8::External::New(this->isolate, &data);
+			v8::AccessorNameSetterCallback setter = nullptr;
+			if constexpr(!std::is_const_v<T> && !std::is_const_v<MemberT> && std::is_copy_assignable_v<MemberT>) {
+				if (!readonly) {
+					setter = _fast_setter_helper<MemberT>;
+				}
+			}
+
+			if (snapshot) {
+				object_template->SetLazyDataProperty(js_name, _fast_getter_helper<MemberT>, external, v8::ReadOnly);
+			} else {
+				object_template->SetAccessor(js_name, _fast_getter_helper<MemberT>, setter, external);
+			}
+		});
+	}
+
+public:
+
+
 
 	/**
 	 * The specified function will be called when the JavaScript object is called like a function
@@ -1405,10 +2405,11 @@ public:
 
 		this->check_if_name_used(method_name);
 
+		auto metrics = this->add_call_metrics(method_name, CallKind::Method);
 
 		// This puts a function on a list that creates a new v8::FunctionTemplate and maps it to "method_name" on the
 		// Object template that will be passed in later when the list is traversed
-		fake_method_adders.emplace_back([this, default_args, method_name, method](v8::Local<v8::ObjectTemplate> prototype_template) {
+		fake_method_adders.emplace_back([this, default_args, method_name, method, metrics](v8::Local<v8::ObjectTemplate> prototype_template) {
 
 			using CopyFunctionType = func::function<R(Head, Tail...)>;
 			using FakeType = std::conditional_t<std::is_const_v<T>, Head, std::remove_const_t<Head>>;
@@ -1417,11 +2418,12 @@ public:
 
 			// This is the actual code associated with "method_name" and called when javascript calls the method
 			StdFunctionCallbackType * method_caller =
-					new StdFunctionCallbackType([method_name, default_args, copy](const v8::FunctionCallbackInfo<v8::Value>& info) {
+					new StdFunctionCallbackType([method_name, default_args, copy, metrics](const v8::FunctionCallbackInfo<v8::Value>& info) {
 
 
 				auto fake_method = *(func::function<R(Head, Tail...)>*)v8::External::Cast(*(info.Data()))->Value();
 				auto isolate = info.GetIsolate();
+				CallTimer timer(metrics);
 
 				// auto holder = info.Holder();
 
@@ -1431,7 +2433,7 @@ public:
                 // a crash here may have something to do with a native override of toString
 
                 auto cpp_object = V8ClassWrapper<T>::get_instance(isolate).get_cpp_object(info.Holder());
-                log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "fake method {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+                V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "fake method {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
 
 
 				// V8 does not support C++ exceptions, so all exceptions must be caught before control
@@ -1440,7 +2442,8 @@ public:
                     //
 				    CallCallable<CopyFunctionType, FakeType>().template operator()(*copy, info, cpp_object, std::make_integer_sequence<int, sizeof...(Tail)>(), default_args); // just Tail..., not Head, Tail...
 				} catch(std::exception & e) {
-					log.error(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running 'fake method' {}::{}: {}",
+					timer.set_exception();
+					V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running 'fake method' {}::{}: {}",
 							    xl::demangle<T>(), method_name, e.what());
 
 					isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
@@ -1449,12 +2452,8 @@ public:
 				return;
 			});
 
-			// create a function template, set the lambda created above to be the handler
-			auto function_template = v8::FunctionTemplate::New(this->isolate);
-			function_template->SetCallHandler(callback_helper, v8::External::New(this->isolate, method_caller));
-
 			// methods are put into the protype of the newly created javascript object
-			prototype_template->Set(make_js_string(method_name), function_template);
+			this->add_prototype_method(prototype_template, method_name, method_caller);
 		});
 	}
 
@@ -1512,6 +2511,7 @@ public:
 
 		this->check_if_name_used(method_name);
 
+		auto metrics = this->add_call_metrics(add_as_callable_object_callback ? "operator()" : method_name, CallKind::Method);
 
 		// adds this method to the list of methods to be added when a new "javascript constructor"
 		// is created for the type being wrapped
@@ -1520,15 +2520,16 @@ public:
 
 				// This is the function called (via a level of indirection because this is a capturing lambda)
 				//   when the JavaScript method is called.
-				[this, default_args_tuple, method, method_name]
+				[this, default_args_tuple, method, method_name, metrics]
 					(const v8::FunctionCallbackInfo<v8::Value> & info) {
 					auto isolate = info.GetIsolate();
+					CallTimer timer(metrics);
 
 					auto self = get_matching_prototype_object(info.Holder());
 
 
 					auto cpp_object = get_cpp_object(self);
-					log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "method '{}' got {} pointer: {}", method_name, xl::demangle<T>(), (void*)cpp_object);
+					V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "method '{}' got {} pointer: {}", method_name, xl::demangle<T>(), (void*)cpp_object);
 					
 					if (cpp_object == nullptr) {
 						auto stack_trace = get_stack_trace_string(v8::StackTrace::CurrentStackTrace(v8::Isolate::GetCurrent(), 100));
@@ -1545,14 +2546,15 @@ public:
 					// V8 does not support C++ exceptions, so all exceptions must be caught before control
 					//   is returned to V8 or the program will instantly terminate
 					try {
-						log.info(LogT::Subjects::WRAPPED_FUNCTION_CALL, "Calling instance member function {}::{}", xl::demangle<T>(), method_name);
-						// make a copy of default_args_tuple so it's non-const - probably better to do this on a per-parameter basis
+						V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_FUNCTION_CALL, "Calling instance member function {}::{}", xl::demangle<T>(), method_name);
+						// default arguments are shared by every call - ParameterBuilder copies one only when the
+						//   parameter type lets the method modify it
 						CallCallable<decltype(bound_method)>()(bound_method, info,
 															   std::make_integer_sequence<int, sizeof...(Args)>{},
-															   std::tuple<DefaultArgTypes...>(
-																   default_args_tuple));
+															   default_args_tuple);
 					} catch (std::exception & e) {
-						log.error(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running method {}::{}: {}",
+						timer.set_exception();
+						V8TOOLKIT_LOG_ERROR(LoggingSubjects::Subjects::RUNTIME_EXCEPTION, "Exception while running method {}::{}: {}",
 								    xl::demangle<T>(), method_name, e.what());
 
 						isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
@@ -1959,6 +2961,64 @@ struct CastToJS<T&&, Behavior, std::enable_if_t<is_wrapped_type_v<T>>> {
 };
 
 
+/**
+ * Wrapped elements of a container being sent to JavaScript look up the class wrapper once per container
+ */
+template<class T>
+struct CastToJSElement<T, CastToJSDefaultBehavior, std::enable_if_t<is_wrapped_type_v<T>>> {
+	v8::Local<v8::Context> context;
+	V8ClassWrapper<T> & wrapper;
+
+	explicit CastToJSElement(v8::Isolate * isolate) :
+		context(isolate->GetCurrentContext()),
+		wrapper(V8ClassWrapper<T>::get_instance(isolate))
+	{}
+
+	// refers to the element in the container, so JavaScript won't delete it
+	v8::Local<v8::Value> operator()(T & element) {
+		return this->wrapper.wrap_existing_cpp_object(this->context, &element, *this->wrapper.destructor_behavior_leave_alone);
+	}
+
+	// the container is going away, so JavaScript gets its own copy of the element
+	v8::Local<v8::Value> operator()(T && element) {
+		return this->wrapper.wrap_existing_cpp_object(this->context, new T(std::move(element)), *this->wrapper.destructor_behavior_delete);
+	}
+};
+
+
+template<class T>
+struct CastToJSElement<T *, CastToJSDefaultBehavior, std::enable_if_t<is_wrapped_type_v<T>>> {
+	v8::Isolate * isolate;
+	v8::Local<v8::Context> context;
+	V8ClassWrapper<T> & wrapper;
+
+	explicit CastToJSElement(v8::Isolate * isolate) :
+		isolate(isolate),
+		context(isolate->GetCurrentContext()),
+		wrapper(V8ClassWrapper<T>::get_instance(isolate))
+	{}
+
+	v8::Local<v8::Value> operator()(T * element) {
+		if (element == nullptr) {
+			return v8::Undefined(this->isolate);
+		}
+#ifdef V8TOOLKIT_BIDIRECTIONAL_ENABLED
+		// JSWrapper objects go back to JavaScript as the JavaScript object they came from
+		if constexpr(std::is_const_v<T>) {
+			if (safe_dynamic_cast<JSWrapper<T> const *>(element) != nullptr) {
+				return CastToJSDefaultBehavior()(element);
+			}
+		} else {
+			if (safe_dynamic_cast<JSWrapper<T> *>(element) != nullptr) {
+				return CastToJSDefaultBehavior()(element);
+			}
+		}
+#endif
+		return this->wrapper.wrap_existing_cpp_object(this->context, element, *this->wrapper.destructor_behavior_leave_alone);
+	}
+};
+
+
 template<typename T, typename Behavior>
 struct CastToNative<T, Behavior, std::enable_if_t<
     !std::is_reference_v<T> &&
@@ -2019,7 +3079,7 @@ struct CastToNative<T&&, Behavior, std::enable_if_t<is_wrapped_type_v<T>>>
 	T&& operator()(v8::Isolate * isolate, v8::Local<v8::Value> value) {
 		v8::Local<v8::Object> object = get_value_as<v8::Object>(isolate, value);
 		T * cpp_object = V8ClassWrapper<T>::get_instance(isolate).get_cpp_object(object);
-		log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "CastToNative T&& got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+		V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "CastToNative T&& got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
 
 		if (V8ClassWrapper<T>::does_object_own_memory(object)) {
 			// do not release the memory because something still needs to call delete on the object (possibly moved out of)
@@ -2043,7 +3103,7 @@ struct CastToNative<T*, Behavior, std::enable_if_t<is_wrapped_type_v<T>>>
 		v8::Local<v8::Object> object = get_value_as<v8::Object>(isolate, value);
 
 		auto cpp_object = wrapper.get_cpp_object(object);
-		log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "CastToNative T* got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+		V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "CastToNative T* got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
 
 		return cpp_object;
 	}
@@ -2074,7 +3134,7 @@ T & get_object_from_embedded_cpp_object(v8::Isolate * isolate, v8::Local<v8::Val
 	V8TOOLKIT_DEBUG("cast to native\n");
 
 	auto cpp_object = V8ClassWrapper<T>::get_instance(isolate).get_cpp_object(get_value_as<v8::Object>(isolate, value));
-	log.info(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "get_object_from_embedded_cpp_object got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
+	V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_DATA_MEMBER_ACCESS, "get_object_from_embedded_cpp_object got {} pointer: {}", xl::demangle<T>(), (void*)cpp_object);
 
 //	 std::cerr << fmt::format("about to call cast on {}",  xl::demangle<T>()) << std::endl;
 	if (cpp_object == nullptr) {
@@ -2176,14 +3236,14 @@ struct ParameterBuilder<T, std::enable_if_t<std::is_reference_v<T> && is_wrapped
 
     template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
 	T /* T& or T&& */ operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-					std::vector<std::unique_ptr<StuffBase>> & stuff,
+					ParameterStorage & stuff,
 					DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 		PB_PRINT("ParameterBuilder handling wrapped type: {} {}",  xl::demangle<T>(),
 				 std::is_rvalue_reference_v<T> ? "&&" : "&");
 		auto isolate = info.GetIsolate();
 
 		if (i >= info.Length()) {
-			return std::forward<T>(*get_default_parameter<NoConstRefT, default_arg_position>(info, i, stuff, default_args_tuple));
+			return std::forward<T>(*get_default_parameter<NoRefT, default_arg_position>(info, i, stuff, default_args_tuple));
 		} else {
 
 			auto & wrapper = V8ClassWrapper<NoRefT>::get_instance(isolate);
@@ -2200,9 +3260,7 @@ struct ParameterBuilder<T, std::enable_if_t<std::is_reference_v<T> && is_wrapped
 						} else if constexpr(std::is_copy_constructible_v<NoConstRefT>)
 						{
 							// make a copy, put it in stuff, and return an rvalue ref to the copy
-							stuff.emplace_back(
-								std::make_unique<Stuff<NoConstRefT>>(std::make_unique<NoRefT>(*cpp_object)));
-							return std::forward<T>(*(static_cast<Stuff<NoConstRefT> &>(*stuff.back()).get()));
+							return std::forward<T>(stuff.emplace<NoConstRefT>(*cpp_object));
 						}
 					}
 					// as a policy, only do this if it's an lvalue reference requested
@@ -2212,15 +3270,12 @@ struct ParameterBuilder<T, std::enable_if_t<std::is_reference_v<T> && is_wrapped
 				}
 			}
             if constexpr(constructed_from_callback_info_v<NoConstRefT>) {
-                stuff.emplace_back(std::make_unique<Stuff<NoConstRefT>>(NoConstRefT(info)));
-                return std::forward<T>(*(static_cast<Stuff<NoConstRefT> &>(*stuff.back()).get()));
+                return std::forward<T>(stuff.emplace<NoConstRefT>(info));
 
             }
 			if constexpr(std::is_move_constructible_v<NoConstRefT> && CastToNative<NoConstRefT>::callable())
 			{
-				auto result = CastToNative<NoConstRefT>()(isolate, value);
-				stuff.emplace_back(std::make_unique<Stuff<NoConstRefT>>(std::move(result)));
-				return std::forward<T>(*(static_cast<Stuff<NoConstRefT> &>(*stuff.back()).get()));
+				return std::forward<T>(stuff.emplace<NoConstRefT>(CastToNative<NoConstRefT>()(isolate, value)));
 			}
 			throw CastException("Could not create requested object of type: {} {}.  Maybe you don't 'own' your memory?",
 								 xl::demangle<T>(),
@@ -2235,14 +3290,14 @@ struct ParameterBuilder<T, std::enable_if_t<std::is_copy_constructible_v<T> && i
 
 	template<int default_arg_position = -1, class DefaultArgsTuple = std::tuple<>>
 	T operator()(const v8::FunctionCallbackInfo<v8::Value> & info, int & i,
-				 std::vector<std::unique_ptr<StuffBase>> & stuff,
+				 ParameterStorage & stuff,
 				 DefaultArgsTuple && default_args_tuple = DefaultArgsTuple()) {
 		PB_PRINT("ParameterBuilder handling wrapped type: {}",  xl::demangle<T>());
 		auto isolate = info.GetIsolate();
 		auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
 
 		if (i >= info.Length()) {
-			return *get_default_parameter<T, default_arg_position>(info, i, stuff, default_args_tuple);
+			return *get_default_parameter<T const, default_arg_position>(info, i, stuff, default_args_tuple);
 		} else {
 			auto value = info[i++];
 			if (value->IsObject()) {
@@ -2261,3 +3316,4 @@ struct ParameterBuilder<T, std::enable_if_t<std::is_copy_constructible_v<T> && i
 
 } // end namespace v8toolkit
 
+#include "container_view.h"
@@ -10,7 +10,7 @@
 namespace v8toolkit {
 
 template<class T>
-WrappedData <T> & V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::get_wrapped_data(v8::Local<v8::Object> object) {
+WrappedObjectHeader & V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::get_wrapped_data(v8::Local<v8::Object> object) {
 
 	if (object->InternalFieldCount() == 0) {
 		throw InvalidCallException(
@@ -18,18 +18,73 @@ WrappedData <T> & V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::
 	}
 
 	auto wrap = v8::Local<v8::External>::Cast(object->GetInternalField(0));
-	WrappedData<T> * wrapped_data = static_cast<WrappedData<T> *>(wrap->Value());
+	WrappedObjectHeader * wrapped_data = static_cast<WrappedObjectHeader *>(wrap->Value());
+	if (wrapped_data == nullptr) {
+		throw InvalidCallException("JavaScript object's native object has already been destroyed along with its ObjectArena");
+	}
 
 	return *wrapped_data;
 }
 
 
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::wrapped_object_weak_callback(v8::WeakCallbackInfo<WrappedData<T>> const & info) {
+	auto isolate = info.GetIsolate();
+	WrappedData<T> * wrapped_data = info.GetParameter();
+	wrapped_data->global.Reset();
+
+	if (wrapped_data->destructor_behavior != nullptr) {
+		(*wrapped_data->destructor_behavior)(isolate, wrapped_data->any_ptr.get());
+	}
+
+	forget_wrapped_data(isolate, wrapped_data);
+}
+
+
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::forget_wrapped_data(v8::Isolate * isolate, WrappedData<T> * wrapped_data) {
+	auto & wrapper = V8ClassWrapper<T>::get_instance(isolate);
+
+	// the javascript object no longer keeps this memory alive
+	isolate->AdjustAmountOfExternalAllocatedMemory(-wrapped_data->external_size);
+	wrapped_data->update_census(-1);
+
+	// a different javascript object may have been associated with the same pointer since this one was created
+	auto existing_wrapped_object = wrapper.existing_wrapped_objects.find(wrapped_data->any_ptr.get());
+	if (existing_wrapped_object != wrapper.existing_wrapped_objects.end() &&
+		existing_wrapped_object->second == wrapped_data) {
+		wrapper.existing_wrapped_objects.erase(existing_wrapped_object);
+	}
+
+	wrapper.unlink_live_wrapped_data(wrapped_data);
+	wrapper.wrapped_data_pool.destroy(wrapped_data);
+}
+
+
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::detach_arena_wrapped_data(v8::Isolate * isolate, WrappedObjectHeader * header) {
+	auto wrapped_data = static_cast<WrappedData<T> *>(header);
+
+	// if the javascript object outlives the arena, make sure it can't reach the destroyed c++ object
+	if (!wrapped_data->global.IsEmpty()) {
+		v8::HandleScope handle_scope(isolate);
+		wrapped_data->global.Get(isolate)->SetInternalField(0, v8::External::New(isolate, nullptr));
+		wrapped_data->global.Reset();
+	}
+
+	forget_wrapped_data(isolate, wrapped_data);
+}
+
+
 template<class T>
 V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::V8ClassWrapper(v8::Isolate * isolate) :
 	isolate(isolate) {
 	wrapper_registery.add_callback(isolate, [this]() {
 		this->isolate_about_to_be_destroyed(this->isolate);
 	});
+	wrapper_registery.add_census_callback(isolate, [this]() {
+		return this->get_census();
+	});
 	this->isolate_to_wrapper_map.emplace(isolate, this);
 }
 
@@ -45,32 +100,60 @@ void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::call_callback
 
 
 template<class T>
-void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::check_if_name_used(std::string_view name) {
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::notify_member_changed(v8::Local<v8::Object> object,
+																					T * cpp_object,
+																					MemberId member_id,
+																					v8::Local<v8::Name> property,
+																					v8::Local<v8::Value> & value) {
+	if (this->batch_member_changes) {
+		// coalesce with any change already queued for this member in the trailing run of changes to the same object
+		bool already_queued = false;
+		for (auto change = this->pending_member_changes.rbegin();
+			 change != this->pending_member_changes.rend() && change->cpp_object == cpp_object;
+			 change++) {
+			if (change->member_id == member_id) {
+				already_queued = true;
+				break;
+			}
+		}
+		if (!already_queued) {
+#ifdef USE_EASTL_FOR_INTERNALS
+			if (this->pending_member_changes.full()) {
+				this->pending_member_changes.set_capacity(std::max<size_t>(this->pending_member_changes.capacity() * 2, 16));
+			}
+#endif
+			this->pending_member_changes.push_back(MemberChange{cpp_object, member_id});
+		}
+	} else {
+		for (auto & callback : this->member_changed_callbacks) {
+			callback(this->isolate, cpp_object, member_id);
+		}
+	}
+
+	// name-based callbacks need the name as a string, so only build it if someone is listening
+	if (!this->property_changed_callbacks.empty()) {
+		this->call_callbacks(object, *v8::String::Utf8Value(this->isolate, property), value);
+	}
+}
+
 
-	if (std::find(used_attribute_name_list.begin(),
-				  used_attribute_name_list.end(),
-				  name) != used_attribute_name_list.end()) {
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::check_if_name_used(std::string_view name) {
 
+	// adds it to the used names if it hasn't been used
+	if (!used_attribute_names.emplace(name).second) {
 		throw DuplicateNameException(
 			fmt::format("Cannot add method/member named '{}' to class '{}', name already in use", name, class_name));
 	}
-
-	// hasn't been used, so add it to used list
-	used_attribute_name_list.emplace_back(name);
-
 }
 
 
 template<class T>
 void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::check_if_static_name_used(const std::string & name) {
-	if (std::find(used_static_attribute_name_list.begin(),
-				  used_static_attribute_name_list.end(),
-				  name) != used_static_attribute_name_list.end()) {
-
+	if (!used_static_attribute_names.insert(name).second) {
 		throw DuplicateNameException(
 			fmt::format("Cannot add static entity named '{}' to class '{}', name already in use", name, class_name));
 	}
-	used_static_attribute_name_list.push_back(name);
 }
 
 
@@ -103,6 +186,48 @@ void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::callback_help
 }
 
 
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::lazy_method_getter(
+	v8::Local<v8::Name> property,
+	v8::PropertyCallbackInfo<v8::Value> const & info) {
+
+	auto isolate = info.GetIsolate();
+	auto lazy_method = static_cast<LazyMethodData *>(v8::External::Cast(*(info.Data()))->Value());
+	lazy_method->materializations++;
+
+	v8::Local<v8::Function> function;
+	if (!v8::Function::New(isolate->GetCurrentContext(), callback_helper,
+						   v8::External::New(isolate, lazy_method->callback)).ToLocal(&function)) {
+		return;
+	}
+	function->SetName(v8::Local<v8::String>::Cast(property));
+	info.GetReturnValue().Set(function);
+}
+
+
+template<class T>
+void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::add_prototype_method(
+	v8::Local<v8::ObjectTemplate> prototype_template,
+	std::string_view method_name,
+	StdFunctionCallbackType * callback) {
+
+	if (this->lazy_methods_flag) {
+		auto & lazy_method = this->lazy_method_data.emplace_back(LazyMethodData{method_name, callback});
+		prototype_template->SetLazyDataProperty(make_js_key(this->isolate, method_name),
+												lazy_method_getter,
+												v8::External::New(this->isolate, &lazy_method));
+	} else {
+		// create a function template, set the callback as the handler
+		auto function_template = v8::FunctionTemplate::New(this->isolate,
+														   callback_helper,
+														   v8::External::New(this->isolate, callback)
+			/*** DO NOT SET A SIGNATURE otherwise traditional JavaScript inheritance objects can't call the function ever ***/
+		);
+		prototype_template->Set(make_js_key(this->isolate, method_name), function_template);
+	}
+}
+
+
 template<class T>
 void V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::register_callback(PropertyChangedCallback callback) {
 	property_changed_callbacks.push_back(callback);
@@ -158,6 +283,7 @@ V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::make_wrapping_func
 template<class T>
 v8::Local<v8::FunctionTemplate>
 V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::get_function_template() {
+	this->run_lazy_registration();
 	if (this_class_function_templates.empty()) {
 //		fprintf(stderr, "Making function template because there isn't one %s\n", xl::demangle<T>().c_str());
 		// this will store it for later use automatically
@@ -186,7 +312,11 @@ T * V8ClassWrapper<T, V8TOOLKIT_V8CLASSWRAPPER_TEMPLATE_SFINAE >::get_cpp_object
 	}
 
 	auto wrap = v8::Local<v8::External>::Cast(object->GetInternalField(0));
-	WrappedData<T> * wrapped_data = static_cast<WrappedData<T> *>(wrap->Value());
+	WrappedObjectHeader * wrapped_data = static_cast<WrappedObjectHeader *>(wrap->Value());
+	if (wrapped_data == nullptr) {
+		throw CastException(fmt::format("Tried to get {} from a JavaScript object whose native object was destroyed along with its ObjectArena",
+										xl::demangle<T>()));
+	}
 	V8TOOLKIT_DEBUG("uncasted internal field: %p\n", wrapped_data->native_object);
 
 	T * result = this->cast(wrapped_data->native_object);
@@ -248,15 +378,8 @@ init_prototype_object_template(v8::Local<v8::ObjectTemplate> object_template) {
 
 		//std::cerr << fmt::format("Class: {} adding method: {}", xl::demangle<T>(), adder.method_name) << std::endl;
 
-		// create a function template, set the lambda created above to be the handler
-		auto function_template = v8::FunctionTemplate::New(this->isolate,
-														   this->callback_helper,
-														   v8::External::New(this->isolate, &adder.callback)
-			/*** DO NOT SET A SIGNATURE otherwise traditional JavaScript inheritance objects can't call the function ever ***/
-		);
-
 		// methods are put into the protype of the newly created javascript object
-		object_template->Set(v8::String::NewFromUtf8(isolate, adder.method_name.c_str()), function_template);
+		this->add_prototype_method(object_template, adder.method_name, &adder.callback);
 	}
 	for (auto & adder : this->fake_method_adders) {
 		adder(object_template);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
 #include <iostream>
@@ -21,6 +23,7 @@
 #include "type_traits.h"
 #include "stdfunctionreplacement.h"
 #include "cast_to_native.h"
+#include "internalized_strings.h"
 
 
 // if it can be determined safely that cxxabi.h is available, include it for name demangling
@@ -51,12 +54,82 @@ v8::Local<T> make_local(v8::Global<T> const & value) {
 }
 
 
+/**
+ * Whether every character is 7-bit ASCII, which is encoded identically as one-byte (Latin-1) and UTF-8
+ */
+inline bool is_ascii(std::string_view string) {
+    for (auto c : string) {
+        if (static_cast<unsigned char>(c) > 0x7f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Returns a javascript string of the specified UTF-8 string.  ASCII strings are created as one-byte strings directly,
+ * skipping UTF-8 decoding.
+ */
+v8::Local<v8::String> make_js_string(v8::Isolate * isolate, std::string_view str);
+
+
 /**
  * Returns a javascript string of the specified string in the GetCurrent() isolate
  */
 v8::Local<v8::String> make_js_string(std::string_view str);
 
 
+/**
+ * Returns a javascript string whose characters are the C++ string's own memory instead of a copy.  JavaScript shares
+ * ownership of the string and releases it when the JavaScript string is garbage collected.  Worthwhile for long
+ * strings, or strings sent to JavaScript many times.  Non-ASCII strings can't be shared this way and are copied.
+ */
+v8::Local<v8::String> make_external_js_string(v8::Isolate * isolate, std::shared_ptr<std::string const> string);
+
+
+/**
+ * Copies a javascript string into a new UTF-8 string of type StringT without an intermediate buffer.  One-byte
+ * strings which are ASCII are copied straight into the result.
+ * @tparam StringT std::string or a type with a compatible resize and operator[]
+ */
+template<class StringT = std::string>
+StringT copy_js_string(v8::Isolate * isolate, v8::Local<v8::String> string) {
+    StringT result;
+    auto length = string->Length();
+    if (length == 0) {
+        return result;
+    }
+    if (string->IsOneByte()) {
+        result.resize(length);
+        string->WriteOneByte(isolate, reinterpret_cast<uint8_t *>(&result[0]), 0, length, v8::String::NO_NULL_TERMINATION);
+        if (is_ascii(std::string_view(&result[0], length))) {
+            return result;
+        }
+    }
+    result.resize(string->Utf8Length(isolate));
+    string->WriteUtf8(isolate, &result[0], static_cast<int>(result.size()), nullptr,
+                      v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+    return result;
+}
+
+
+/**
+ * Returns the UTF-8 contents of a javascript string in a per-thread buffer which is reused by every call, so no
+ * memory is allocated once the buffer has grown large enough.
+ * The returned view is only valid until the next call on the same thread.
+ */
+inline std::string_view get_utf8_scratch(v8::Isolate * isolate, v8::Local<v8::String> string) {
+    static thread_local std::string scratch;
+    scratch.resize(string->Utf8Length(isolate));
+    if (!scratch.empty()) {
+        string->WriteUtf8(isolate, &scratch[0], static_cast<int>(scratch.size()), nullptr,
+                          v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+    }
+    return scratch;
+}
+
+
 /**
  * Returns a std::string representing the string value for the value passed in
  * For string/symbol it is its own value, otherwise it is the to_string of the value
@@ -410,27 +483,6 @@ void for_each_own_property(const v8::Local<v8::Object> object, T && callable)
 
 
 
-struct StuffBase{
-    // virtual destructor makes sure derived class destructor is called to actually
-    //   delete the data
-    virtual ~StuffBase(){}
-};
-
-
-template<class T>
-struct Stuff : public StuffBase {
-    Stuff(T && t) : stuffed(std::make_unique<T>(std::move(t))) {}
-    Stuff(std::unique_ptr<T> t) : stuffed(std::move(t)) {}
-
-
-    static std::unique_ptr<Stuff<T>> stuffer(T && t) {return std::make_unique<Stuff<T>>(std::move(t));}
-    static std::unique_ptr<Stuff<T>> stuffer(T const & t) {return std::make_unique<Stuff<T>>(std::move(const_cast<T &>(t)));}
-
-    T * get(){return stuffed.get();}
-    std::unique_ptr<T> stuffed;
-};
-
-
 template<typename T, typename U>
 std::optional<v8::Local<T>> get_value_as_optional(U && value_input) {
     auto value = make_local(value_input);
@@ -536,17 +588,14 @@ auto get_value_as(U && value) {
 }
 
 
-template<typename T, typename U>
-auto get_key_as(v8::Local<v8::Context> context, U && input, std::string_view key) {
+template<typename T, typename U, typename Key = std::string_view>
+auto get_key_as(v8::Local<v8::Context> context, U && input, Key key) {
 
     auto object = get_value_as<v8::Object>(input);
     
     auto isolate = context->GetIsolate();
     // printf("Looking up key %s\n", key.c_str());
-    auto get_maybe = object->Get(context, v8::String::NewFromUtf8(isolate, 
-                                                                  key.data(), 
-                                                                  v8::String::NewStringType::kNormalString, 
-                                                                  key.length()));
+    auto get_maybe = object->Get(context, make_js_key(isolate, key));
 
     if(get_maybe.IsEmpty() || get_maybe.ToLocalChecked()->IsUndefined()) {
 //        if (get_maybe.IsEmpty()) {
@@ -554,7 +603,11 @@ auto get_key_as(v8::Local<v8::Context> context, U && input, std::string_view key
 //        } else {
 //            std::cerr << "undefined" << std::endl;
 //        }
-        throw UndefinedPropertyException(std::string(key));
+        if constexpr(std::is_convertible_v<Key, std::string_view>) {
+            throw UndefinedPropertyException(std::string(key));
+        } else {
+            throw UndefinedPropertyException(std::string(key.value()));
+        }
     }
     return get_value_as<T>(isolate, get_maybe.ToLocalChecked());
 }
@@ -570,8 +623,8 @@ auto get_key_as(v8::Local<v8::Value> object, std::string_view key) {
 }
 
 
-template<class T>
-auto get_key_as(v8::Local<v8::Context> context, v8::Global<v8::Value> & object, std::string_view key) {
+template<class T, typename Key = std::string_view>
+auto get_key_as(v8::Local<v8::Context> context, v8::Global<v8::Value> & object, Key key) {
     return get_key_as<T>(context, object.Get(context->GetIsolate()), key);
 }
 
@@ -597,11 +650,12 @@ std::optional<v8::Local<Result>> get_property_as(T && input_value, std::string_v
     v8::Local<v8::Object> local_object = local_value->ToObject(context).ToLocalChecked();
 
     // if it doesn't have the property at all, don't return undefined
-    if (!local_object->HasOwnProperty(context, make_js_string(key)).FromMaybe(false)) {
+    auto js_key = make_js_key(isolate, key);
+    if (!local_object->HasOwnProperty(context, js_key).FromMaybe(false)) {
         return {};
     }
     
-    auto get_result = local_object->Get(context, make_js_string(key));
+    auto get_result = local_object->Get(context, js_key);
     if (get_result.IsEmpty()) {
         return {};
     }
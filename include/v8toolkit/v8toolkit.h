@@ -15,6 +15,7 @@
 
 #include "call_callable.h"
 #include "exceptions.h"
+#include "call_metrics.h"
 
 #ifndef _MSC_VER
 #include <dirent.h>
@@ -77,6 +78,7 @@ template<class R, class... Args>
 struct FunctionTemplateData {
     func::function<R(Args...)> callable;
     std::string name;
+    CallMetrics * metrics = nullptr;
 };
 
 
@@ -88,11 +90,13 @@ struct FunctionTemplateData {
 template <class R, class... Args>
 v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate,
                                                        func::function<R(Args...)> f,
-                                                       std::string const & name)
+                                                       std::string const & name,
+                                                       CallMetrics * metrics = nullptr)
 {
     auto data = new FunctionTemplateData<R, Args...>();
     data->callable = f;
     data->name = name;
+    data->metrics = metrics;
 
     // wrap the actual call in this lambda
     return v8::FunctionTemplate::New(isolate, [](const v8::FunctionCallbackInfo<v8::Value>& info) {
@@ -100,10 +104,12 @@ v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate,
 
         FunctionTemplateData<R, Args...> & data = *(FunctionTemplateData<R, Args...> *)v8::External::Cast(*(info.Data()))->Value();
 
+        CallTimer timer(data.metrics);
         try {
             CallCallable<decltype(data.callable)>()(data.callable, info, std::make_integer_sequence<int, sizeof...(Args)>{});
 
         } catch (std::exception & e) {
+            timer.set_exception();
 
             isolate->ThrowException(v8::String::NewFromUtf8(isolate, e.what()));
 
@@ -143,9 +149,9 @@ func::function<R(Args...)> make_std_function_from_callable(R(CLASS::*f)(Args...)
 * Creates a v8::FunctionTemplate for an arbitrary callable
 */
 template<class T>
-v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate, T callable, std::string name)
+v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate, T callable, std::string name, CallMetrics * metrics = nullptr)
 {
-    return make_function_template(isolate, make_std_function_from_callable(&T::operator(), callable), name);
+    return make_function_template(isolate, make_std_function_from_callable(&T::operator(), callable), name, metrics);
 }
 
 
@@ -153,9 +159,9 @@ v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate, T
 * Creates a function template from a c-style function pointer
 */
 template <class R, class... Args>
-v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate,  R(*f)(Args...), std::string const & name)
+v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate,  R(*f)(Args...), std::string const & name, CallMetrics * metrics = nullptr)
 {
-    return make_function_template(isolate, func::function<R(Args...)>(f), name);
+    return make_function_template(isolate, func::function<R(Args...)>(f), name, metrics);
 }
 
 
@@ -165,7 +171,8 @@ v8::Local<v8::FunctionTemplate> make_function_template(v8::Isolate * isolate,  R
 */
 template<class R, class... Args>
 void add_function(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & object_template, const char * name, func::function<R(Args...)> function) {
-    object_template->Set(isolate, name, make_function_template(isolate, function, name));
+    object_template->Set(isolate, name, make_function_template(isolate, function, name,
+                                                               &CallMetricsRegistry::get(isolate).add("", name, CallKind::Function)));
 }
 
 
@@ -176,7 +183,8 @@ void add_function(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & o
 template<class T>
 void add_function(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & object_template, const char * name, T callable) {
         function_type_t<T> f(callable);
-    object_template->Set(isolate, name, make_function_template(isolate, f, name));
+    object_template->Set(isolate, name, make_function_template(isolate, f, name,
+                                                               &CallMetricsRegistry::get(isolate).add("", name, CallKind::Function)));
 }
 
 
@@ -186,7 +194,8 @@ void add_function(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & o
 */
 template<class R, class... Args>
 void add_function(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & object_template, const char * name, R(*function)(Args...)) {
-    object_template->Set(isolate, name, make_function_template(isolate, function, name));
+    object_template->Set(isolate, name, make_function_template(isolate, function, name,
+                                                               &CallMetricsRegistry::get(isolate).add("", name, CallKind::Function)));
 }
 
 
@@ -201,9 +210,10 @@ void add_function(const v8::Local<v8::Context> & context, const v8::Local<v8::Ob
     CONTEXT_SCOPED_RUN(context);
 
     auto isolate = context->GetIsolate();
-    auto function_template = make_function_template(isolate, callable, name);
+    auto function_template = make_function_template(isolate, callable, name,
+                                                    &CallMetricsRegistry::get(isolate).add("", name, CallKind::Function));
     auto function = function_template->GetFunction(context).ToLocalChecked();
-    (void)object->Set(context, v8::String::NewFromUtf8(isolate, name), function);
+    (void)object->Set(context, make_js_key(isolate, name), function);
 }
 
 
@@ -278,7 +288,7 @@ void _variable_setter(v8::Local<v8::Name> property, v8::Local<v8::Value> value,
 */
 template<class T>
 void expose_variable(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & object_template, const char * name, T & variable) {
-    object_template->SetAccessor(v8::String::NewFromUtf8(isolate, name),
+    object_template->SetAccessor(make_js_key(isolate, name),
                                  _variable_getter<T>,
                                  _variable_setter<T>,
                                  v8::External::New(isolate, &variable));
@@ -290,7 +300,7 @@ template<class T, class... Rest>
                       const v8::Local<v8::ObjectTemplate> & object_template,
                       const char * name,
                       std::unique_ptr<T, Rest...> & variable) {
-object_template->SetAccessor(v8::String::NewFromUtf8(isolate, name),
+object_template->SetAccessor(make_js_key(isolate, name),
                              _variable_getter<std::unique_ptr<T, Rest...>&>,
                              _variable_setter<std::unique_ptr<T, Rest...>&>,
                              v8::External::New(isolate, variable.get()));
@@ -304,7 +314,7 @@ object_template->SetAccessor(v8::String::NewFromUtf8(isolate, name),
 */
 template<class T>
 void expose_variable_readonly(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & object_template, const char * name, T & variable) {
-    object_template->SetAccessor(v8::String::NewFromUtf8(isolate, name),
+    object_template->SetAccessor(make_js_key(isolate, name),
                                  _variable_getter<T>,
                                  0,
                                  v8::External::New(isolate, &variable));
@@ -319,7 +329,7 @@ template<class T>
 void expose_variable(v8::Local<v8::Context> context, const v8::Local<v8::Object> & object, const char * name, T & variable) {
     auto isolate = context->GetIsolate();
     if (object->SetAccessor(context,
-            v8::String::NewFromUtf8(isolate, name),
+            make_js_key(isolate, name),
             _variable_getter<T>,
             _variable_setter<T>,
             v8::External::New(isolate, &variable)).IsNothing()) {
@@ -336,7 +346,7 @@ void expose_variable(v8::Local<v8::Context> context, const v8::Local<v8::Object>
 template<class T>
 void expose_variable_readonly(v8::Local<v8::Context> context, const v8::Local<v8::Object> & object, const char * name, T & variable) {
     auto isolate = context->GetIsolate();
-    object->SetAccessor(v8::String::NewFromUtf8(isolate, name), _variable_getter<T>, 0, v8::External::New(isolate, &variable));
+    object->SetAccessor(make_js_key(isolate, name), _variable_getter<T>, 0, v8::External::New(isolate, &variable));
 }
 
 
@@ -22,6 +22,36 @@ Context::Context(std::shared_ptr<Isolate> isolate_helper,
 {}
 
 
+void Context::shutdown() {
+    // destroys all C++ objects created from JavaScript in this context in one pass
+    this->object_arena.reset();
+
+    this->forget_cached_expressions();
+}
+
+
+void Context::forget_cached_expressions() {
+    if (auto expression_cache = ExpressionCache::find(this->isolate)) {
+        GLOBAL_CONTEXT_SCOPED_RUN(isolate, context);
+        expression_cache->forget_context(this->get_context());
+    }
+}
+
+
+void Context::enable_object_arena(size_t chunk_size) {
+    if (this->object_arena) {
+        throw InvalidCallException("Context already has an ObjectArena");
+    }
+    GLOBAL_CONTEXT_SCOPED_RUN(isolate, context);
+    this->object_arena = std::make_unique<ObjectArena>(this->isolate, this->get_context(), chunk_size);
+}
+
+
+ObjectArena * Context::get_object_arena() const {
+    return this->object_arena.get();
+}
+
+
 v8::Local<v8::Context> Context::get_context() const {
     return context.Get(isolate);
 }
@@ -52,6 +82,9 @@ Context::~Context() {
 //    std::cerr << fmt::format("v8toolkit::Context being destroyed (isolate: {})", (void *)this->isolate) << std::endl;
     log.info(LoggingSubjects::Subjects::V8_OBJECT_MANAGEMENT, "V8 context object destroyed");
 
+    // otherwise the v8::Context would live on until its expressions are evicted or the isolate goes away
+    this->forget_cached_expressions();
+
 }
 
 
@@ -338,6 +371,9 @@ Isolate::~Isolate()
 #endif
 
     wrapper_registery.cleanup_isolate(this->isolate);
+    CallMetricsRegistry::release(this->isolate);
+    InternalizedStrings::release(this->isolate);
+    ExpressionCache::release(this->isolate);
 
     // clean up any modules loaded with `require`
     delete_require_cache_for_isolate(this->isolate);
@@ -358,15 +394,24 @@ void Isolate::add_assert()
         auto isolate = info.GetIsolate();
         auto context = isolate->GetCurrentContext();
 
+        // the same assertions tend to be checked over and over, so compile each one once if it's an expression and
+        //   remember the ones that aren't, which are run as a script below
+        auto expression_function = ExpressionCache::get(isolate).get_function_if_expression(
+            context, *v8::String::Utf8Value(isolate, info[0]), {});
+
         v8::TryCatch tc(isolate);
-        auto script_maybe = v8::Script::Compile(context, info[0]->ToString(context).ToLocalChecked());
-        if(tc.HasCaught()) {
-            // printf("Caught compilation error\n");
-            tc.ReThrow();
-            return;
+        v8::MaybeLocal<v8::Value> result_maybe;
+        if (!expression_function.IsEmpty()) {
+            result_maybe = expression_function->Call(context, context->Global(), 0, nullptr);
+        } else {
+            auto script_maybe = v8::Script::Compile(context, info[0]->ToString(context).ToLocalChecked());
+            if(tc.HasCaught()) {
+                // printf("Caught compilation error\n");
+                tc.ReThrow();
+                return;
+            }
+            result_maybe = script_maybe.ToLocalChecked()->Run(context);
         }
-        auto script = script_maybe.ToLocalChecked();
-        auto result_maybe = script->Run(context);
         if(tc.HasCaught()) {
             // printf("Caught runtime exception\n");
             tc.ReThrow();
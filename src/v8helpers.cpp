@@ -368,14 +368,62 @@ bool is_reserved_word_in_static_context(std::string const & name) {
 }
 
 
-v8::Local<v8::String> make_js_string(std::string_view str) {
-    auto isolate = v8::Isolate::GetCurrent();
+v8::Local<v8::String> make_js_string(v8::Isolate * isolate, std::string_view str) {
+    if (is_ascii(str)) {
+        return v8::String::NewFromOneByte(isolate,
+                                          reinterpret_cast<uint8_t const *>(str.data()),
+                                          v8::NewStringType::kNormal,
+                                          static_cast<int>(str.length())).ToLocalChecked();
+    }
     return v8::String::NewFromUtf8(isolate,
                                    str.data(),
                                    v8::String::NewStringType::kNormalString,
                                    str.length());
 }
 
+v8::Local<v8::String> make_js_string(std::string_view str) {
+    return make_js_string(v8::Isolate::GetCurrent(), str);
+}
+
+
+namespace {
+
+/**
+ * Keeps a C++ string alive for as long as a JavaScript string using its memory exists
+ */
+class SharedExternalString : public v8::String::ExternalOneByteStringResource {
+    std::shared_ptr<std::string const> string;
+
+public:
+    SharedExternalString(std::shared_ptr<std::string const> string) : string(std::move(string)) {}
+
+    char const * data() const override {
+        return this->string->data();
+    }
+
+    size_t length() const override {
+        return this->string->length();
+    }
+};
+
+} // end anonymous namespace
+
+
+v8::Local<v8::String> make_external_js_string(v8::Isolate * isolate, std::shared_ptr<std::string const> string) {
+    if (!is_ascii(*string)) {
+        return make_js_string(isolate, *string);
+    }
+
+    // V8 deletes the resource when the string is garbage collected
+    auto resource = new SharedExternalString(std::move(string));
+    v8::Local<v8::String> result;
+    if (!v8::String::NewExternalOneByte(isolate, resource).ToLocal(&result)) {
+        delete resource;
+        throw V8Exception(isolate, "Could not create external string");
+    }
+    return result;
+}
+
 std::string make_cpp_string(v8::Local<v8::Value> value) {
     auto isolate = v8::Isolate::GetCurrent();
     auto context = isolate->GetCurrentContext();
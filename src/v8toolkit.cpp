@@ -59,7 +59,7 @@ void add_variable(v8::Isolate * isolate, const v8::Local<v8::ObjectTemplate> & o
 void add_variable(const v8::Local<v8::Context> context, const v8::Local<v8::Object> & object, const char * name, const v8::Local<v8::Value> value) 
 {
     auto isolate = context->GetIsolate();
-    (void)object->Set(context, v8::String::NewFromUtf8(isolate, name), value);
+    (void)object->Set(context, make_js_key(isolate, name), value);
 }
 
 
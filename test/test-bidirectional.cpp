@@ -1,12 +1,130 @@
 #include "../include/v8toolkit/bidirectional.h"
+#include "testing.h"
 
 
 
 
 class BidirectionalCppClass {
-    
+
 public:
     virtual void virtual_void_func(){}
-    
-    
-};
\ No newline at end of file
+
+
+};
+
+
+class BidirectionalThing : public WrappedClassBase {
+public:
+    virtual ~BidirectionalThing() = default;
+    virtual std::string get_string() {return "C++";}
+    int i = 5;
+};
+
+class JSBidirectionalThing : public BidirectionalThing, public JSWrapper<BidirectionalThing> {
+public:
+    JSBidirectionalThing() :
+        JSWrapper(static_cast<BidirectionalThing *>(this))
+    {}
+
+    JS_ACCESS(std::string, get_string, get_string);
+};
+
+
+// creates another JSWrapper<BidirectionalThing> before the JSWrapper of the object being constructed
+struct CreatesOtherWrapper {
+    std::unique_ptr<JSBidirectionalThing> other = std::make_unique<JSBidirectionalThing>();
+};
+
+class JSNestingThing : public CreatesOtherWrapper, public BidirectionalThing, public JSWrapper<BidirectionalThing> {
+public:
+    JSNestingThing() :
+        JSWrapper(static_cast<BidirectionalThing *>(this))
+    {}
+
+    JS_ACCESS(std::string, get_string, get_string);
+};
+
+
+class BidirectionalFixture : public JavaScriptFixture {
+public:
+    BidirectionalFixture() {
+        ISOLATE_SCOPED_RUN(*i);
+        {
+            auto & w = V8ClassWrapper<BidirectionalThing>::get_instance(*i);
+            w.add_method("get_string", &BidirectionalThing::get_string);
+            w.add_member<&BidirectionalThing::i>("i");
+            w.set_compatible_types<JSBidirectionalThing, JSNestingThing>();
+            w.finalize();
+        }
+        {
+            auto & w = V8ClassWrapper<JSBidirectionalThing>::get_instance(*i);
+            w.set_parent_type<BidirectionalThing>();
+            w.finalize();
+        }
+        {
+            auto & w = V8ClassWrapper<JSNestingThing>::get_instance(*i);
+            w.set_parent_type<BidirectionalThing>();
+            w.finalize();
+        }
+        create_context();
+    }
+};
+
+
+TEST_F(BidirectionalFixture, JSAccessOverrides) {
+    (*c)([&]() {
+        JSBidirectionalThing thing;
+        c->add_variable("thing", thing.get_javascript_object());
+
+        // the wrapped C++ method found on the prototype isn't an override
+        EXPECT_EQ(thing.get_string(), "C++");
+        EXPECT_EQ(thing.get_string(), "C++");
+
+        // overridden after the first call
+        c->run("thing.get_string = function() { return 'own'; };");
+        EXPECT_EQ(thing.get_string(), "own");
+
+        // overridden further up the prototype chain
+        c->run("delete thing.get_string; Object.getPrototypeOf(thing).get_string = function() { return 'prototype'; };");
+        EXPECT_EQ(thing.get_string(), "prototype");
+
+        c->run("Object.setPrototypeOf(thing, {get_string() { return 'new prototype'; }});");
+        EXPECT_EQ(thing.get_string(), "new prototype");
+    });
+}
+
+
+TEST_F(BidirectionalFixture, FactoryPrototypes) {
+    (*c)([&]() {
+        using ThingFactory = ConcreteFactory<BidirectionalThing, TypeList<>, TypeList<>>;
+        ThingFactory cpp_factory(ThingFactory::CppFactoryInfo<BidirectionalThing>{});
+
+        auto prototype = get_value_as<v8::Object>(isolate, c->run("({get_string() { return 'JS'; }})").Get(isolate));
+        auto constructor = get_value_as<v8::Function>(isolate, c->run("(function() { this.per_object = 1; })").Get(isolate));
+        ThingFactory js_factory(ThingFactory::JSFactoryInfo<JSNestingThing>(&cpp_factory, prototype, constructor));
+
+        std::unique_ptr<BidirectionalThing> thing(js_factory.create());
+        auto nesting_thing = static_cast<JSNestingThing *>(thing.get());
+        EXPECT_EQ(thing->get_string(), "JS");
+
+        c->add_variable("thing", nesting_thing->get_javascript_object());
+        c->add_variable("other", nesting_thing->other->get_javascript_object());
+        c->add_variable("prototype", prototype);
+        c->add_variable("BidirectionalThing", V8ClassWrapper<BidirectionalThing>::get_instance(isolate).
+            get_function_template()->GetFunction(c->get_context()).ToLocalChecked());
+
+        c->run(R"(
+            EXPECT_TRUE(Object.getPrototypeOf(thing) === prototype);
+            EXPECT_TRUE(thing instanceof BidirectionalThing);
+            EXPECT_EQJS(thing.i, 5);
+            thing.i = 6;
+            EXPECT_EQJS(thing.per_object, 1);
+
+            // the wrapper created while constructing thing didn't take its prototype
+            EXPECT_TRUE(Object.getPrototypeOf(other) !== prototype);
+            EXPECT_EQJS(other.get_string(), "C++");
+        )");
+        EXPECT_EQ(thing->i, 6);
+        EXPECT_EQ(nesting_thing->other->get_string(), "C++");
+    });
+}
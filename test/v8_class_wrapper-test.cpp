@@ -1,5 +1,7 @@
 #include "testing.h"
 #include <array>
+#include "v8toolkit/associative_view.h"
+#include "v8toolkit/keyed_collection_casts.h"
 
 
 TEST_F(JavaScriptFixture, NumberTypes) {
@@ -97,6 +99,23 @@ TEST_F(JavaScriptFixture, StringTypes) {
         // These return unique_ptr<char[]> because otherwise there wouldn't be any memory for the char * to point tos
         EXPECT_STREQ(CastToNative<char *>()(*i, CastToJS<char const *>()(*i, "test string")).get(), "test string");
         EXPECT_STREQ(CastToNative<char const *>()(*i, CastToJS<char const *>()(*i, "test string")).get(), "test string");
+
+        // one-byte strings which aren't ASCII still come back as UTF-8
+        EXPECT_EQ(CastToNative<std::string>()(*i, CastToJS<std::string>()(*i, "caf\u00e9")), "caf\u00e9");
+        EXPECT_EQ(CastToNative<std::string>()(*i, c->run("'caf\\u00e9'").Get(*i)), "caf\u00e9");
+        EXPECT_EQ(CastToNative<std::string>()(*i, c->run("'\\u2603 snowman'").Get(*i)), "\u2603 snowman");
+        EXPECT_EQ(CastToNative<std::string>()(*i, CastToJS<std::string>()(*i, "")), "");
+        EXPECT_EQ(CastToNative<std::string>()(*i, CastToJS<int>()(*i, 5)), "5");
+
+        EXPECT_EQ(CastToNative<std::vector<std::string>>()(*i, c->run("['a', 'b\\u00e9', 3]").Get(*i)),
+                  (std::vector<std::string>{"a", "b\u00e9", "3"}));
+
+        // long shared strings use the C++ string's memory
+        auto shared_string = std::make_shared<std::string const>(2000, 'x');
+        auto js_string = CastToJS<std::shared_ptr<std::string const>>()(*i, shared_string);
+        EXPECT_TRUE(v8::Local<v8::String>::Cast(js_string)->IsExternal());
+        EXPECT_EQ(shared_string.use_count(), 2);
+        EXPECT_EQ(CastToNative<std::string>()(*i, js_string), *shared_string);
     });
 }
 
@@ -224,6 +243,130 @@ TEST_F(JavaScriptFixture, Vectors) {
 }
 
 
+template<>
+struct v8toolkit::cast_to_js_as_typed_array<float> : std::true_type {};
+
+TEST_F(JavaScriptFixture, TypedArrays) {
+
+    this->create_context();
+
+    (*c)([&] {
+        {
+            std::vector<float> v{1.5, 2.5, 3.5};
+            auto data = v.data();
+            c->add_variable("v", CastToJS<decltype(v)>()(*i, std::move(v)));
+            c->run("EXPECT_TRUE(v instanceof Float32Array); EXPECT_EQJS(v[1], 2.5); EXPECT_EQJS(v.length, 3);");
+
+            // the vector's storage became the ArrayBuffer's backing store
+            auto js_v = c->run("v");
+            auto typed_array = v8::Local<v8::TypedArray>::Cast(js_v.Get(*i));
+            EXPECT_EQ(typed_array->Buffer()->GetContents().Data(), data);
+        }
+        {
+            std::vector<float> const cv{1.5, 2.5};
+            c->add_variable("cv", CastToJS<decltype(cv)>()(*i, cv));
+            c->run("EXPECT_TRUE(cv instanceof Float32Array); EXPECT_EQJS(cv[0], 1.5);");
+        }
+        {
+            // opted out element types are still Arrays
+            std::vector<int> v{1, 2};
+            c->add_variable("iv", CastToJS<decltype(v)>()(*i, v));
+            c->run("EXPECT_TRUE(Array.isArray(iv));");
+        }
+
+        // matching element type is copied directly
+        {
+            auto vector = CastToNative<std::vector<double>>()(*i, c->run("new Float64Array([1.5, 2.5, 3.5])").Get(*i));
+            EXPECT_EQ(vector, (std::vector<double>{1.5, 2.5, 3.5}));
+        }
+        // different element type is converted element by element out of the backing store
+        {
+            auto vector = CastToNative<std::vector<int>>()(*i, c->run("new Uint8Array([1, 2, 255]).subarray(1)").Get(*i));
+            EXPECT_EQ(vector, (std::vector<int>{2, 255}));
+        }
+        // elements which may not fit are converted the same way as those of an Array
+        {
+            auto from_typed_array = CastToNative<std::vector<int32_t>>()(*i, c->run("new Float64Array([NaN, 1e20, -2.5])").Get(*i));
+            auto from_array = CastToNative<std::vector<int32_t>>()(*i, c->run("[NaN, 1e20, -2.5]").Get(*i));
+            EXPECT_EQ(from_typed_array, from_array);
+            EXPECT_EQ(from_typed_array[0], 0);
+            EXPECT_EQ(from_typed_array[2], -2);
+        }
+    });
+}
+
+
+TEST_F(JavaScriptFixture, Spans) {
+
+    this->create_context();
+
+    (*c)([&] {
+        c->add_function("checksum", [](Span<uint8_t const> bytes) {
+            uint32_t sum = 0;
+            for (auto byte : bytes) {
+                sum += byte;
+            }
+            return sum;
+        });
+        c->add_function("scale", [](Span<float> floats, float factor) {
+            for (auto & f : floats) {
+                f *= factor;
+            }
+        });
+        c->add_function("string_length", [](std::string_view string) {
+            return string.size();
+        });
+        c->add_function("byte_string", [](Span<char const> bytes) {
+            return std::string(bytes.begin(), bytes.end());
+        });
+
+        // byte spans view any buffer
+        c->run("EXPECT_EQJS(checksum(new Uint8Array([1, 2, 3])), 6);");
+        c->run("EXPECT_EQJS(checksum(new Uint8Array([1, 2, 3]).subarray(1)), 5);");
+        c->run("EXPECT_EQJS(checksum(new Uint8Array([4, 5]).buffer), 9);");
+
+        // writes go straight to the TypedArray
+        c->run("var floats = new Float32Array([1, 2.5]); scale(floats, 2); EXPECT_EQJS(floats[1], 5);");
+
+        // string_views get the string conversion of buffers, their bytes take a Span
+        c->run("EXPECT_EQJS(string_length(new Uint8Array([104, 105, 33])), 10);");
+        c->run("EXPECT_EQJS(string_length('hello'), 5);");
+        c->run("EXPECT_EQJS(byte_string(new Uint8Array([104, 105, 33])), 'hi!');");
+
+        // wrong element type, partial elements, or not a buffer at all
+        EXPECT_THROW(c->run("scale(new Int32Array(2), 2)"), V8Exception);
+        EXPECT_THROW(c->run("scale(new ArrayBuffer(3), 2)"), V8Exception);
+        EXPECT_THROW(c->run("checksum([1, 2, 3])"), V8Exception);
+    });
+}
+
+
+TEST_F(JavaScriptFixture, LargeArrays) {
+
+    this->create_context();
+
+    (*c)([&] {
+        // larger than the stack buffer arrays are normally built in
+        std::vector<int> v(1000);
+        for (int n = 0; n < 1000; n++) {
+            v[n] = n;
+        }
+        c->add_variable("v", CastToJS<std::vector<int> &>()(*i, v));
+        c->run("EXPECT_EQJS(v.length, 1000); EXPECT_EQJS(v[999], 999); EXPECT_TRUE(Array.isArray(v));");
+
+        std::deque<int> d(v.begin(), v.end());
+        c->add_variable("d", CastToJS<std::deque<int> &>()(*i, d));
+        c->run("EXPECT_EQJS(d.length, 1000); EXPECT_EQJS(d[500], 500);");
+
+        c->add_variable("empty", CastToJS<std::vector<int>>()(*i, std::vector<int>{}));
+        c->run("EXPECT_EQJS(empty.length, 0);");
+
+        c->add_variable("t", CastToJS<std::tuple<int, std::string>>()(*i, std::tuple<int, std::string>(1, "two")));
+        c->run("EXPECT_EQJS(t.length, 2); EXPECT_EQJS(t[1], 'two');");
+    });
+}
+
+
 TEST_F(JavaScriptFixture, Sets) {
 
     this->create_context();
@@ -364,6 +507,92 @@ TEST_F(JavaScriptFixture, Maps) {
     });
 }
 
+TEST_F(JavaScriptFixture, KeyedCollections) {
+
+    this->create_context();
+
+    (*c)([&] {
+        // integer keys stay numbers and array values aren't split apart
+        {
+            std::map<int, std::vector<int>> m{{1, {10, 11}}, {2, {20}}};
+            c->add_variable("m", CastToJSKeyedCollectionsBehavior()(m));
+            c->run("EXPECT_TRUE(m instanceof Map); EXPECT_TRUE(m.get(1).length == 2); EXPECT_TRUE(m.get('1') === undefined);");
+
+            auto round_trip = CastToNativeKeyedCollectionsBehavior().operator()<std::map<int, std::vector<int>>>(c->run("m").Get(*i));
+            EXPECT_EQ(round_trip, m);
+        }
+        // sets become Set objects
+        {
+            std::set<int> s{1, 2, 3};
+            c->add_variable("s", CastToJSKeyedCollectionsBehavior()(s));
+            c->run("EXPECT_TRUE(s instanceof Set); EXPECT_TRUE(s.has(2)); EXPECT_TRUE(s.size == 3);");
+
+            auto round_trip = CastToNativeKeyedCollectionsBehavior().operator()<std::unordered_set<int>>(c->run("new Set([4, 5, 4])").Get(*i));
+            EXPECT_EQ(round_trip, (std::unordered_set<int>{4, 5}));
+        }
+        // nested containers use the same behavior
+        {
+            std::unordered_map<std::string, std::set<int>> m{{"a", {1, 2}}};
+            c->add_variable("nested", CastToJSKeyedCollectionsBehavior()(m));
+            c->run("EXPECT_TRUE(nested.get('a') instanceof Set);");
+        }
+        // multimaps group values by key
+        {
+            std::multimap<int, int> m{{1, 1}, {1, 2}, {2, 3}};
+            c->add_variable("mm", CastToJSKeyedCollectionsBehavior()(m));
+            c->run("EXPECT_TRUE(mm.get(1).length == 2);");
+
+            auto round_trip = CastToNativeKeyedCollectionsBehavior().operator()<std::multimap<int, int>>(c->run("mm").Get(*i));
+            EXPECT_EQ(round_trip, m);
+        }
+        // plain objects and arrays are still accepted
+        {
+            auto map = CastToNativeKeyedCollectionsBehavior().operator()<std::map<std::string, int>>(c->run("({a: 1, b: 2})").Get(*i));
+            EXPECT_EQ(map.size(), 2);
+            auto set = CastToNativeKeyedCollectionsBehavior().operator()<std::set<int>>(c->run("[3, 2, 1]").Get(*i));
+            EXPECT_EQ(set.size(), 3);
+        }
+    });
+}
+
+
+TEST_F(JavaScriptFixture, AssociativeViews) {
+
+    this->create_context();
+
+    (*c)([&] {
+        {
+            auto m = std::make_shared<std::map<std::string, int>>(std::map<std::string, int>{{"a", 1}, {"b", 2}, {"c", 3}});
+            c->add_variable("m", CastToJS<AssociativeView<std::map<std::string, int>>>()(*i, AssociativeView(m)));
+            c->run("EXPECT_EQJS(m.size, 3);"
+                   "EXPECT_EQJS(m.get('b'), 2);"
+                   "EXPECT_TRUE(m.get('z') === undefined);"
+                   "EXPECT_TRUE(m.has('c'));"
+                   "EXPECT_TRUE(!m.has('z'));"
+                   "assert_contents(new Map(m), new Map([['a', 1], ['b', 2], ['c', 3]]));"
+                   "it = m[Symbol.iterator](); it.next();");
+
+            // the view and its iterators stop working once the container is gone
+            m.reset();
+            EXPECT_THROW(c->run("m.get('a')"), V8Exception);
+            EXPECT_THROW(c->run("it.next()"), V8Exception);
+        }
+        {
+            std::set<int> s{1, 2, 3};
+            AssociativeView view(s);
+            c->add_variable("s", CastToJS<decltype(view)>()(*i, view));
+            c->run("assert_contents(Array.from(s), [1, 2, 3]); EXPECT_EQJS(s.get(2), 2);");
+            view.invalidate();
+            EXPECT_THROW(c->run("s.has(1)"), V8Exception);
+        }
+        {
+            std::multimap<std::string, int> mm{{"a", 1}, {"a", 2}, {"b", 3}};
+            c->add_variable("mm", CastToJS<AssociativeView<decltype(mm)>>()(*i, AssociativeView(mm)));
+            c->run("assert_contents(mm.get('a'), [1, 2]);");
+        }
+    });
+}
+
 
 /**
  * Move each of these into its own test for its container type
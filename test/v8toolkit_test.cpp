@@ -1,5 +1,7 @@
 #include "testing.h"
 #include "v8toolkit/cast_to_native_impl.h"
+#include "v8toolkit/js_function.h"
+#include "v8toolkit/log.h"
 
 
 TEST_F(JavaScriptFixture, RequireErrors) {
@@ -45,6 +47,91 @@ TEST_F(JavaScriptFixture, GetPropertyAs) {
 
 }
 
+TEST_F(JavaScriptFixture, InternalizedKeys) {
+
+    this->create_context();
+
+    (*c)([&]{
+        auto key = make_js_key(isolate, "some_key");
+        EXPECT_TRUE(key->StrictEquals(make_js_key(isolate, std::string("some_key"))));
+        EXPECT_TRUE(make_js_key(isolate, V8TOOLKIT_STRING_KEY("some_key"))->StrictEquals(key));
+        EXPECT_TRUE(make_js_key(isolate, V8TOOLKIT_STRING_KEY("other_key"))->StrictEquals(make_js_key(isolate, "other_key")));
+
+        auto object = c->run("({some_key: 1, other_key: 2})");
+        EXPECT_EQ(CastToNative<int>()(isolate, get_key_as<v8::Value>(c->get_context(), object.Get(isolate), V8TOOLKIT_STRING_KEY("other_key"))), 2);
+        EXPECT_EQ(CastToNative<int>()(isolate, get_key_as<v8::Value>(c->get_context(), object.Get(isolate), "some_key")), 1);
+        EXPECT_THROW(get_key_as<v8::Value>(c->get_context(), object.Get(isolate), V8TOOLKIT_STRING_KEY("missing")), UndefinedPropertyException);
+    });
+}
+
+TEST_F(JavaScriptFixture, JSFunction) {
+
+    this->create_context();
+
+    (*c)([&]{
+        auto add = get_value_as<v8::Function>(isolate, c->run("(function(a, b) { return a + b; })").Get(isolate));
+        JSFunction<int(int, int)> js_add(isolate, c->get_context(), add);
+        EXPECT_EQ(js_add(1, 2), 3);
+        EXPECT_EQ(js_add.call_in_scope(3, 4), 7);
+
+        auto object = get_value_as<v8::Object>(isolate, c->run("({value: 'x', get(suffix) { return this.value + suffix; }})").Get(isolate));
+        auto get = JSFunction<std::string(std::string const &)>::from_method(c->get_context(), object, "get");
+        EXPECT_EQ(get("y"), "xy");
+        EXPECT_THROW(JSFunction<void()>::from_method(c->get_context(), object, "value"), InvalidCallException);
+
+        auto throws = get_value_as<v8::Function>(isolate, c->run("(function() { throw new Error('thrown'); })").Get(isolate));
+        EXPECT_THROW(JSFunction<void()>(isolate, c->get_context(), throws)(), V8ExecutionException);
+    });
+}
+
+
+TEST_F(JavaScriptFixture, ExpressionCache) {
+
+    this->create_context();
+
+    (*c)([&]{
+        auto & cache = ExpressionCache::get(isolate);
+        cache.clear();
+
+        EXPECT_EQ(c->evaluate<int>("a + b", {"a", "b"}, 1, 2), 3);
+        EXPECT_EQ(c->evaluate<int>("a + b", {"a", "b"}, 3, 4), 7);
+        EXPECT_EQ(cache.size(), 1);
+
+        // same source with different parameter names is a different expression
+        EXPECT_EQ(c->evaluate<std::string>("a + b", {"b", "a"}, std::string("x"), std::string("y")), "yx");
+        EXPECT_EQ(cache.size(), 2);
+
+        // statements are only compiled once, too
+        EXPECT_TRUE(cache.get_function_if_expression(c->get_context(), "var x = 1;", {}).IsEmpty());
+        EXPECT_TRUE(cache.get_function_if_expression(c->get_context(), "var x = 1;", {}).IsEmpty());
+        EXPECT_EQ(cache.size(), 3);
+        EXPECT_THROW(cache.get_function(c->get_context(), "var x = 1;", {}), V8CompilationException);
+        EXPECT_EQ(cache.size(), 3);
+
+        // destroying a context drops its expressions
+        {
+            auto other = i->create_context();
+            EXPECT_EQ(other->evaluate<int>("a + b", {"a", "b"}, 1, 2), 3);
+            EXPECT_EQ(cache.size(), 4);
+        }
+        EXPECT_EQ(cache.size(), 3);
+
+        cache.set_capacity(1);
+        EXPECT_EQ(cache.size(), 1);
+        EXPECT_EQ(c->evaluate<int>("a + b", {"a", "b"}, 5, 6), 11);
+        EXPECT_EQ(cache.size(), 1);
+
+        EXPECT_THROW(c->evaluate<int>("a +", {"a"}, 1), V8CompilationException);
+        EXPECT_THROW(c->evaluate<int>("a", {"a", "b"}, 1), InvalidCallException);
+        EXPECT_THROW(c->evaluate<int>("(() => { throw new Error('thrown'); })()", {}), V8ExecutionException);
+
+        c->shutdown();
+        EXPECT_EQ(cache.size(), 0);
+        cache.set_capacity(ExpressionCache::DefaultCapacity);
+    });
+}
+
+
 TEST_F(JavaScriptFixture, ReleaseRequiredModulesBeforeIsolateGoesAway) {
 
     this->create_context();
@@ -120,3 +207,56 @@ TEST_F(JavaScriptFixture, Stringify) {
     stringify_value(big_object.Get(c->get_isolate()));
 }
 
+
+
+TEST(Logging, SubjectGating) {
+    static_assert(log_subject_compiled(LoggingSubjects::Subjects::WRAPPED_FUNCTION_CALL));
+
+    std::vector<std::string> messages;
+    auto & callback = v8toolkit::log.add_callback([&](LogT::LogMessage const & message) {
+        if (message.subject == LogT::Subjects::WRAPPED_FUNCTION_CALL) {
+            messages.push_back(message.string);
+        }
+    });
+    int evaluations = 0;
+    auto argument = [&]{evaluations++; return 1;};
+
+    V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_FUNCTION_CALL, "enabled {}", argument());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(messages, std::vector<std::string>{"enabled 1"});
+
+    // arguments aren't evaluated for disabled subjects
+    v8toolkit::log.set_status(LogT::Subjects::WRAPPED_FUNCTION_CALL, false);
+    V8TOOLKIT_LOG_ERROR(LogT::Subjects::WRAPPED_FUNCTION_CALL, "disabled {}", argument());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_EQ(messages.size(), 1);
+    v8toolkit::log.set_status(LogT::Subjects::WRAPPED_FUNCTION_CALL, true);
+
+    v8toolkit::log.remove_callback(callback);
+}
+
+
+TEST(Logging, LogRingBuffer) {
+    std::vector<std::string> messages;
+    auto & callback = v8toolkit::log.add_callback([&](LogT::LogMessage const & message) {
+        if (message.subject == LogT::Subjects::WRAPPED_FUNCTION_CALL) {
+            messages.push_back(message.string);
+        }
+    });
+
+    {
+        LogRingBuffer ring_buffer(4);
+        ring_buffer.install();
+        EXPECT_EQ(LogRingBuffer::get_installed(), &ring_buffer);
+
+        std::string temporary = "string";
+        V8TOOLKIT_LOG_INFO(LogT::Subjects::WRAPPED_FUNCTION_CALL, "{} {} {}", temporary, 2, 3.5);
+        temporary = "changed";
+
+        // formats everything still queued before returning
+    }
+    EXPECT_EQ(LogRingBuffer::get_installed(), nullptr);
+    EXPECT_EQ(messages, std::vector<std::string>{"string 2 3.5"});
+
+    v8toolkit::log.remove_callback(callback);
+}
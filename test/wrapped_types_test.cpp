@@ -1,6 +1,7 @@
 
 
 #include "v8toolkit/v8_class_wrapper.h"
+#include "v8toolkit/associative_view.h"
 #include "v8toolkit/javascript.h"
 #include "v8toolkit/wrapped_class_base.h"
 #include "testing.h"
@@ -64,7 +65,9 @@ public:
             throw CastException("Invalid parameters to WrappedClass constructor taking FunctionCallbackInfo object");
         }
     }
-    virtual ~WrappedClass(){}
+    virtual ~WrappedClass(){destructor_count++;}
+
+    static inline int destructor_count = 0;
 
     int constructor_i;
     int i = 5;
@@ -76,6 +79,8 @@ public:
 
     std::string string = "string value";
 
+    std::vector<int> int_vector = {1, 2, 3};
+
     int takes_int_5(int x) {
         EXPECT_EQ(x, 5);
         return x;
@@ -113,6 +118,12 @@ public:
         this->default_parameters_called = true;
     };
 
+    // modifies its parameter, which must not change the default value for later calls
+    std::string modifies_default_parameter(std::string & s) {
+        s += "!";
+        return s;
+    }
+
     WrappedClass & returns_wrapped_class_lvalue() {
         returns_wrapped_class_lvalue_called = true;
         return *this;
@@ -198,12 +209,75 @@ public:
 };
 
 
+// standard layout, for add_member_fast / add_member_snapshot
+struct FastMemberStruct : public WrappedClassBase {
+    int i = 1;
+    double d = 2.5;
+};
+
+
 class WrappedString : public WrappedClassBase {
 public:
     std::string string;
     WrappedString(std::string string) : string(string) {}
 };
 
+// several constructors registered on the same JavaScript constructor function
+class OverloadedConstructors : public WrappedClassBase {
+public:
+    std::string called;
+    OverloadedConstructors(int) : called("int") {}
+    OverloadedConstructors(std::string const &, int) : called("string, int") {}
+    OverloadedConstructors(bool) : called("bool") {}
+};
+
+// methods created on first use
+class LazyMethodsClass : public WrappedClassBase {
+public:
+    int used() {return 1;}
+    int unused() {return 2;}
+};
+
+// registered the first time a script uses them
+class LazyParent : public WrappedClassBase {
+public:
+    virtual ~LazyParent() = default;
+    int parent_method() {return 1;}
+};
+class LazyChild : public LazyParent {
+public:
+    int child_method() {return 2;}
+};
+
+// report the memory they own through ExternalSize
+class SizedParent : public WrappedClassBase {
+public:
+    virtual ~SizedParent() = default;
+    std::vector<char> buffer;
+};
+class SizedChild : public SizedParent {
+public:
+    std::vector<char> child_buffer;
+};
+
+namespace v8toolkit {
+template<>
+struct ExternalSize<SizedParent> {
+    size_t operator()(SizedParent const & sized) const {return 100 + sized.buffer.size();}
+};
+template<>
+struct ExternalSize<SizedChild> {
+    size_t operator()(SizedChild const & sized) const {return 1000 + sized.buffer.size() + sized.child_buffer.size();}
+};
+}
+
+class DuplicateNames : public WrappedClassBase {
+public:
+    int a = 1;
+    int b() {return 2;}
+    static int c() {return 3;}
+};
+
 namespace v8toolkit {
 CAST_TO_NATIVE(WrappedString, {
     return WrappedString(CastToNative<std::string>()(isolate, value));
@@ -228,6 +302,7 @@ namespace v8toolkit {
             w.add_member<&WrappedClass::string>("string");
             w.add_member<&WrappedClass::copyable_wrapped_class>("copyable_wrapped_class");
             w.add_member<&WrappedClass::up_wrapped_class>("up_wrapped_class");
+            w.add_member_view<&WrappedClass::int_vector>("int_vector", true);
             w.add_method("takes_int_5", &WrappedClass::takes_int_5);
 //            w.add_method("takes_number", &WrappedClass::takes_number);
 
@@ -254,6 +329,7 @@ namespace v8toolkit {
                              CopyableWrappedClass,
                              CopyableWrappedClass,
                              CopyableWrappedClass*>(1, "asdf", {}, {}, {}, nullptr));
+            w.add_method("modifies_default_parameter", &WrappedClass::modifies_default_parameter, std::tuple<std::string>("default"));
             w.add_method("takes_and_returns_enum", &WrappedClass::takes_and_returns_enum);
             w.add_member<&WrappedClass::unique_ptr_wrapped_class>("unique_ptr_wrapped_class");
             w.add_static_method("static_method", &WrappedClass::static_method, std::make_tuple(5, "asdf"));
@@ -313,6 +389,14 @@ public:
             w.add_constructor<>("CopyableWrappedClass", *i);
         }
 
+        {
+            auto & w = V8ClassWrapper<FastMemberStruct>::get_instance(*i);
+            w.add_member_fast<&FastMemberStruct::i>("i");
+            w.add_member_snapshot<&FastMemberStruct::d>("d");
+            w.finalize();
+            w.add_constructor<>("FastMemberStruct", *i);
+        }
+
         {
             auto & w = V8ClassWrapper<WrappedString>::get_instance(*i);
             w.add_member<&WrappedString::string>("string");
@@ -320,6 +404,54 @@ public:
             w.add_constructor<std::string const &>("WrappedString", *i);
         }
 
+        {
+            auto & w = V8ClassWrapper<OverloadedConstructors>::get_instance(*i);
+            w.add_member<&OverloadedConstructors::called>("called");
+            w.finalize();
+            w.add_constructor<TypeList<int>, TypeList<std::string const &, int>, TypeList<bool>>("OverloadedConstructors", *i);
+        }
+
+        {
+            auto & w = V8ClassWrapper<SizedParent>::get_instance(*i);
+            w.set_compatible_types<SizedChild>();
+            w.finalize();
+        }
+        {
+            auto & w = V8ClassWrapper<SizedChild>::get_instance(*i);
+            w.set_parent_type<SizedParent>();
+            w.finalize();
+        }
+
+        {
+            auto & w = V8ClassWrapper<LazyMethodsClass>::get_instance(*i);
+            w.set_lazy_methods();
+            w.add_method("used", &LazyMethodsClass::used);
+            w.add_method("unused", &LazyMethodsClass::unused);
+            w.add_method("fake", [](LazyMethodsClass * self){return self->used() + 10;});
+            w.finalize();
+            w.add_constructor<>("LazyMethodsClass", *i);
+        }
+
+        {
+            auto & w = V8ClassWrapper<LazyParent>::get_instance(*i);
+            w.set_lazy_registration([](auto & w) {
+                w.template set_compatible_types<LazyChild>();
+                w.add_method("parent_method", &LazyParent::parent_method);
+                w.finalize();
+            });
+            w.add_lazy_constructor<>("LazyParent", *i);
+        }
+        {
+            // registered before its parent, which is registered first when it's needed
+            auto & w = V8ClassWrapper<LazyChild>::get_instance(*i);
+            w.set_lazy_registration([](auto & w) {
+                w.template set_parent_type<LazyParent>();
+                w.add_method("child_method", &LazyChild::child_method);
+                w.finalize();
+            });
+            w.add_lazy_constructor<>("LazyChild", *i);
+        }
+
 
 
         i->add_function("takes_wrapped_class_lvalue", [](WrappedClass & wrapped_class){
@@ -560,6 +692,10 @@ TEST_F(WrappedClassFixture, DefaultParameters) {
         auto result = c->run("let wc = new WrappedClass(11); wc.default_parameters(); wc;");
         WrappedClass * pwc = CastToNative<WrappedClass *>()(*i, result.Get(*i));
         EXPECT_TRUE(pwc->default_parameters_called);
+
+        c->run("EXPECT_EQJS(wc.modifies_default_parameter(), 'default!');"
+               "EXPECT_EQJS(wc.modifies_default_parameter(), 'default!');"
+               "EXPECT_EQJS(wc.modifies_default_parameter('passed'), 'passed!');");
     });
 
 }
@@ -771,3 +907,353 @@ TEST_F(WrappedClassFixture, PimplMember) {
     });
 }
 
+
+
+TEST_F(WrappedClassFixture, OwningObjectsDeletedOnGarbageCollection) {
+    (*c)([&]() {
+        WrappedClass::destructor_count = 0;
+        c->run("(function(){for (let i = 0; i < 100; i++) {new WrappedClass(i);}})();");
+        c->isolate->LowMemoryNotification();
+        EXPECT_GT(WrappedClass::destructor_count, 0);
+
+        // while its javascript object is alive, wrapping the same pointer returns the same object
+        WrappedClass wc(1);
+        auto first = c->wrap_object(&wc);
+        auto second = c->wrap_object(&wc);
+        EXPECT_TRUE(first->StrictEquals(second));
+    });
+}
+
+
+TEST_F(WrappedClassFixture, WrappedObjectCensus) {
+    auto & w = V8ClassWrapper<WrappedClass>::get_instance(*i);
+    auto before = w.get_census();
+    WrappedClass wc(1);
+
+    (*c)([&]() {
+        auto owning = c->run("new WrappedClass(1)");
+        auto non_owning = c->wrap_object(&wc);
+
+        auto census = w.get_census();
+        EXPECT_EQ(census.owning_objects, before.owning_objects + 1);
+        EXPECT_EQ(census.owning_external_bytes, before.owning_external_bytes + (int64_t)sizeof(WrappedClass));
+        EXPECT_EQ(census.non_owning_objects, before.non_owning_objects + 1);
+        EXPECT_EQ(census.existing_wrapped_objects, before.existing_wrapped_objects + 2);
+
+        bool found = false;
+        for (auto & class_census : i->get_wrapped_object_census()) {
+            if (class_census.class_name == census.class_name) {
+                found = true;
+                EXPECT_EQ(class_census.owning_objects, census.owning_objects);
+            }
+        }
+        EXPECT_TRUE(found);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, ExternalSize) {
+    auto & parent_wrapper = V8ClassWrapper<SizedParent>::get_instance(*i);
+    auto & child_wrapper = V8ClassWrapper<SizedChild>::get_instance(*i);
+    auto before = child_wrapper.get_census().non_owning_external_bytes;
+    SizedChild child;
+
+    (*c)([&]() {
+        auto object = c->wrap_object(&child)->ToObject(c->get_context()).ToLocalChecked();
+        EXPECT_EQ(child_wrapper.get_census().non_owning_external_bytes, before + 1000);
+
+        // recomputed with the ExternalSize of the type the object was wrapped as, not the base wrapper's type
+        child.buffer.resize(10);
+        parent_wrapper.update_external_size(object);
+        EXPECT_EQ(child_wrapper.get_census().non_owning_external_bytes, before + 1010);
+
+        child.child_buffer.resize(5);
+        EXPECT_TRUE(child_wrapper.update_external_size(&child));
+        EXPECT_EQ(child_wrapper.get_census().non_owning_external_bytes, before + 1015);
+
+        // not wrapped by this wrapper
+        SizedParent parent;
+        EXPECT_FALSE(parent_wrapper.update_external_size(&parent));
+    });
+}
+
+
+TEST_F(WrappedClassFixture, ObjectArenaOwnsObjectsCreatedFromJavaScript) {
+    c->enable_object_arena();
+    (*c)([&]() {
+        WrappedClass::destructor_count = 0;
+        c->run("arena_wc = new WrappedClass(1); (function(){for (let i = 0; i < 100; i++) {new WrappedClass(i);}})();");
+        EXPECT_EQ(c->get_object_arena()->size(), 101);
+
+        // garbage collection doesn't destroy arena-owned objects
+        c->isolate->LowMemoryNotification();
+        EXPECT_EQ(WrappedClass::destructor_count, 0);
+        c->run("EXPECT_EQJS(arena_wc.constructor_i, 1);");
+    });
+
+    c->shutdown();
+    EXPECT_EQ(WrappedClass::destructor_count, 101);
+
+    // javascript object which outlived the arena no longer refers to a c++ object
+    (*c)([&]() {
+        EXPECT_THROW(c->run("takes_wrapped_class_lvalue(arena_wc);"), V8Exception);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, FastAndSnapshotMembers) {
+    (*c)([&]() {
+        auto result = c->run("f = new FastMemberStruct(); EXPECT_EQJS(f.i, 1); f.i = 5; EXPECT_EQJS(f.i, 5); EXPECT_EQJS(f.d, 2.5); f;");
+        auto fast_member_struct = CastToNative<FastMemberStruct *>()(*i, result.Get(*i));
+        EXPECT_EQ(fast_member_struct->i, 5);
+
+        // snapshot members keep the value from the first read
+        fast_member_struct->d = 3.5;
+        c->run("EXPECT_EQJS(f.d, 2.5);");
+        c->run("f.d = 4.5; EXPECT_EQJS(f.d, 2.5);");
+    });
+}
+
+
+TEST_F(WrappedClassFixture, MemberChangeNotifications) {
+    auto & w = V8ClassWrapper<WrappedClass>::get_instance(*i);
+    auto i_id = w.get_member_id("i");
+    auto ci_id = w.get_member_id("ci");
+    std::vector<V8ClassWrapper<WrappedClass>::MemberId> changes;
+    w.register_member_changed_callback([&](v8::Isolate *, WrappedClass *, auto member_id) {
+        changes.push_back(member_id);
+    });
+
+    (*c)([&]() {
+        c->run("wc = new WrappedClass(1); wc.i = 2; wc.i = 3;");
+    });
+    EXPECT_EQ(changes, (std::vector<V8ClassWrapper<WrappedClass>::MemberId>{i_id, i_id}));
+    changes.clear();
+
+    // batched changes are coalesced and only delivered when drained
+    w.set_member_change_batching(true);
+    (*c)([&]() {
+        c->run("wc.i = 4; wc.i = 5; wc.ci = 6;");
+    });
+    EXPECT_TRUE(changes.empty());
+    EXPECT_EQ(w.drain_member_changes(), 2);
+    EXPECT_EQ(changes, (std::vector<V8ClassWrapper<WrappedClass>::MemberId>{i_id, ci_id}));
+    w.set_member_change_batching(false);
+}
+
+
+TEST_F(WrappedClassFixture, CallMetrics) {
+    auto & metrics = i->get_call_metrics();
+    auto find_entry = [&](std::string const & class_name, std::string const & name, CallKind kind) {
+        for (auto & entry : metrics.get_report()) {
+            if (entry.class_name == class_name && entry.name == name && entry.kind == kind) {
+                return entry;
+            }
+        }
+        ADD_FAILURE() << "no metrics for " << name;
+        return CallMetricsReportEntry{};
+    };
+    auto class_name = xl::demangle<WrappedClass>();
+
+    // nothing recorded until enabled
+    (*c)([&]() {
+        c->run("wc = new WrappedClass(1); wc.takes_int_5(5);");
+    });
+    EXPECT_EQ(find_entry(class_name, "takes_int_5", CallKind::Method).calls, 0);
+
+    metrics.set_enabled(true);
+    (*c)([&]() {
+        c->run("wc = new WrappedClass(1); wc.takes_int_5(5); wc.takes_int_5(5); wc.i = wc.i + 1;");
+        // insufficient parameters
+        EXPECT_THROW(c->run("wc.takes_int_5()"), V8Exception);
+    });
+    metrics.set_enabled(false);
+
+    auto method = find_entry(class_name, "takes_int_5", CallKind::Method);
+    EXPECT_EQ(method.calls, 3);
+    EXPECT_EQ(method.exceptions, 1);
+    uint64_t histogram_total = 0;
+    for (auto count : method.latency_histogram) {
+        histogram_total += count;
+    }
+    EXPECT_EQ(histogram_total, 3);
+    EXPECT_GT(method.get_latency_percentile(0.99), 0);
+
+    EXPECT_EQ(find_entry(class_name, "WrappedClass", CallKind::Constructor).calls, 1);
+    EXPECT_EQ(find_entry(class_name, "i", CallKind::Accessor).calls, 2);
+
+    metrics.reset();
+    EXPECT_EQ(find_entry(class_name, "takes_int_5", CallKind::Method).calls, 0);
+
+    // adding the same function to each new context reuses its metrics
+    auto report_size = metrics.get_report().size();
+    for (int n = 0; n < 3; n++) {
+        auto context = i->create_context();
+        context->add_function("per_context_function", []{});
+    }
+    EXPECT_EQ(metrics.get_report().size(), report_size + 1);
+}
+
+
+TEST_F(WrappedClassFixture, ContainerViews) {
+    (*c)([&]() {
+        c->run("wc = new WrappedClass(1);"
+               "EXPECT_EQJS(wc.int_vector.length, 3);"
+               "EXPECT_EQJS(wc.int_vector[1], 2);"
+               "EXPECT_TRUE(wc.int_vector[3] === undefined);"
+               "wc.int_vector[1] = 20;"
+               "EXPECT_EQJS(wc.int_vector[1], 20);"
+               "EXPECT_EQJS(Object.keys(wc.int_vector).length, 3);"
+               "let sum = 0; for (let x of wc.int_vector) {sum += x;}"
+               "EXPECT_EQJS(sum, 24);"
+        );
+        auto wc = c->run("wc");
+        auto cpp_object = CastToNative<WrappedClass *>()(*i, wc.Get(*i));
+        EXPECT_EQ(cpp_object->int_vector[1], 20);
+
+        // changes to the C++ container are visible through the view
+        cpp_object->int_vector.push_back(4);
+        c->run("EXPECT_EQJS(wc.int_vector.length, 4); EXPECT_EQJS(wc.int_vector[3], 4);");
+
+        // writing past the end throws
+        EXPECT_THROW(c->run("wc.int_vector[10] = 1;"), V8Exception);
+
+        // returned from a function
+        std::vector<int> numbers = {5, 6};
+        c->add_function("get_numbers", [&]{return ContainerView(numbers);});
+        c->run("numbers = get_numbers(); numbers[0] = 50; EXPECT_EQJS(numbers[0], 5);");
+    });
+}
+
+
+TEST_F(WrappedClassFixture, AssociativeViewsAreNotWrappedObjects) {
+    (*c)([&]() {
+        std::map<std::string, int> m{{"a", 1}};
+        c->add_variable("m", CastToJS<AssociativeView<decltype(m)>>()(*i, AssociativeView(m)));
+        c->add_function("wants_wrapped_class", [&](WrappedClass &) {});
+
+        EXPECT_THROW(c->run("wants_wrapped_class(m);"), V8Exception);
+        EXPECT_THROW(c->run("wants_wrapped_class(m[Symbol.iterator]());"), V8Exception);
+
+        // view methods called on an iterator don't treat its data as the view's
+        EXPECT_THROW(c->run("m.get.call(m[Symbol.iterator](), 'a');"), V8Exception);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, ArraysOfWrappedObjects) {
+    (*c)([&]() {
+        std::vector<WrappedClass *> pointers;
+        std::vector<WrappedClass> objects;
+        for (int n = 0; n < 100; n++) {
+            objects.emplace_back(n);
+        }
+        for (auto & object : objects) {
+            pointers.push_back(&object);
+        }
+        pointers.push_back(nullptr);
+
+        c->add_variable("pointers", CastToJS<std::vector<WrappedClass *> &>()(*i, pointers));
+        c->run("EXPECT_EQJS(pointers.length, 101);"
+               "EXPECT_EQJS(pointers[99].constructor_i, 99);"
+               "EXPECT_TRUE(pointers[100] === undefined);");
+
+        // the same C++ object gets the same JavaScript object
+        c->add_variable("objects", CastToJS<std::vector<WrappedClass> &>()(*i, objects));
+        c->run("EXPECT_TRUE(objects[5] === pointers[5]);");
+
+        // moved out of an expiring vector into objects JavaScript owns
+        c->add_variable("moved", CastToJS<std::vector<WrappedClass>>()(*i, std::move(objects)));
+        c->run("EXPECT_EQJS(moved.length, 100); EXPECT_EQJS(moved[42].constructor_i, 42);");
+
+        // const containers hand out const elements
+        std::deque<WrappedClass> deque;
+        deque.emplace_back(1);
+        deque.emplace_back(2);
+        std::deque<WrappedClass> const & const_deque = deque;
+        c->add_variable("const_deque", CastToJS<std::deque<WrappedClass> const &>()(*i, const_deque));
+        c->run("EXPECT_EQJS(const_deque.length, 2); EXPECT_EQJS(const_deque[1].constructor_i, 2);");
+
+        std::array<WrappedClass, 2> const const_array{WrappedClass(3), WrappedClass(4)};
+        c->add_variable("const_array", CastToJS<std::array<WrappedClass, 2> const &>()(*i, const_array));
+        c->run("EXPECT_EQJS(const_array.length, 2); EXPECT_EQJS(const_array[0].constructor_i, 3);");
+    });
+}
+
+
+TEST_F(WrappedClassFixture, ConstructorOverloads) {
+    (*c)([&]() {
+        c->run("EXPECT_EQJS(new OverloadedConstructors(1).called, 'int');"
+               "EXPECT_EQJS(new OverloadedConstructors('a', 1).called, 'string, int');"
+               "EXPECT_EQJS(new OverloadedConstructors(true).called, 'bool');");
+
+        // no signature's types match, so the first one taking that many arguments converts them
+        c->run("EXPECT_EQJS(new OverloadedConstructors('2').called, 'int');");
+
+        // no signature takes this few arguments
+        EXPECT_THROW(c->run("new OverloadedConstructors()"), V8Exception);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, DuplicateNames) {
+    (*c)([&]() {
+        auto & w = V8ClassWrapper<DuplicateNames>::get_instance(*i);
+        w.add_member<&DuplicateNames::a>("a");
+        w.add_method("b", &DuplicateNames::b);
+        EXPECT_THROW(w.add_method("a", &DuplicateNames::b), DuplicateNameException);
+        EXPECT_THROW(w.add_member<&DuplicateNames::a>("b"), DuplicateNameException);
+
+        // static names are separate from instance names
+        w.add_static_method("a", &DuplicateNames::c);
+        EXPECT_THROW(w.add_static_method("a", &DuplicateNames::c), DuplicateNameException);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, LazyMethods) {
+    (*c)([&]() {
+        c->run("var lazy = new LazyMethodsClass();"
+               "EXPECT_EQJS(lazy.used(), 1);"
+               "EXPECT_EQJS(lazy.used(), 1);"
+               "EXPECT_EQJS(lazy.fake(), 11);"
+               "EXPECT_EQJS(lazy.used.name, 'used');"
+               "EXPECT_TRUE(Object.getPrototypeOf(lazy).hasOwnProperty('unused'));");
+
+        auto materializations = V8ClassWrapper<LazyMethodsClass>::get_instance(*i).get_lazy_method_materializations();
+        EXPECT_EQ(materializations["used"], 1);
+        EXPECT_EQ(materializations["fake"], 1);
+        EXPECT_EQ(materializations["unused"], 0);
+    });
+}
+
+
+TEST_F(WrappedClassFixture, LazyRegistration) {
+    EXPECT_FALSE(V8ClassWrapper<LazyParent>::get_instance(*i).is_finalized());
+    EXPECT_FALSE(V8ClassWrapper<LazyChild>::get_instance(*i).is_finalized());
+
+    (*c)([&]() {
+        c->run("var child = new LazyChild();"
+               "EXPECT_EQJS(child.child_method(), 2);"
+               "EXPECT_EQJS(child.parent_method(), 1);"
+               "EXPECT_EQJS(new LazyParent().parent_method(), 1);");
+    });
+
+    EXPECT_TRUE(V8ClassWrapper<LazyParent>::get_instance(*i).is_finalized());
+    EXPECT_TRUE(V8ClassWrapper<LazyChild>::get_instance(*i).is_finalized());
+}
+
+
+TEST_F(WrappedClassFixture, LazyRegistrationFromCpp) {
+    LazyChild child;
+    (*c)([&]() {
+        // returned from C++ before any script has used the class
+        c->add_function("get_lazy_child", [&]{return &child;});
+        c->run("var child = get_lazy_child();"
+               "EXPECT_EQJS(child.child_method(), 2);"
+               "EXPECT_EQJS(child.parent_method(), 1);");
+    });
+
+    EXPECT_TRUE(V8ClassWrapper<LazyParent>::get_instance(*i).is_finalized());
+    EXPECT_TRUE(V8ClassWrapper<LazyChild>::get_instance(*i).is_finalized());
+}